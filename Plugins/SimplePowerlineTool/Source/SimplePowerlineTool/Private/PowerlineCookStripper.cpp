@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineCookStripper.h"
+#include "PowerlineToolSettings.h"
+#include "Components/SplineComponent.h"
+#include "Components/SplineMeshComponent.h"
+#include "Engine/Level.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+
+const FName FPowerlineCookStripper::CableSplineTag(TEXT("PowerlineCableSpline"));
+
+namespace PowerlineCookStripper
+{
+	static int64 GetSplineBytes(const USplineComponent* SplineComp)
+	{
+		const FSplineCurves& Curves = SplineComp->SplineCurves;
+		return SplineComp->GetClass()->GetStructureSize()
+			+ Curves.Position.Points.GetAllocatedSize()
+			+ Curves.Rotation.Points.GetAllocatedSize()
+			+ Curves.Scale.Points.GetAllocatedSize()
+			+ Curves.ReparamTable.Points.GetAllocatedSize()
+			+ SplineComp->ComponentTags.GetAllocatedSize();
+	}
+}
+
+FPowerlineCookStripper::FPowerlineCookStripper()
+{
+	PreSaveHandle = FCoreUObjectDelegates::OnObjectPreSave.AddRaw(this, &FPowerlineCookStripper::OnObjectPreSave);
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FPowerlineCookStripper::OnPackageSaved);
+}
+
+FPowerlineCookStripper::~FPowerlineCookStripper()
+{
+	FCoreUObjectDelegates::OnObjectPreSave.Remove(PreSaveHandle);
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+}
+
+void FPowerlineCookStripper::OnObjectPreSave(UObject* Object, FObjectPreSaveContext Context)
+{
+	if (!Context.IsCooking() || !GetDefault<UPowerlineToolSettings>()->bStripCableSplinesOnCook) return;
+
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		StripActor(Actor);
+	}
+}
+
+int32 FPowerlineCookStripper::StripActor(AActor* Actor)
+{
+	USceneComponent* RootComp = Actor->GetRootComponent();
+	if (!RootComp) return 0;
+
+	FPowerlineStripStats Stats;
+	TInlineComponentArray<USplineComponent*> Splines(Actor);
+	for (USplineComponent* SplineComp : Splines)
+	{
+		if (SplineComp->IsEditorOnly() || !SplineComp->ComponentHasTag(CableSplineTag)) continue;
+
+		// Segments keep their relative transform on the root, which only matches when the spline sits on it without an offset
+		const bool bMovable = SplineComp->GetAttachParent() == RootComp && SplineComp->GetRelativeTransform().Equals(FTransform::Identity);
+		const TArray<TObjectPtr<USceneComponent>>& Children = SplineComp->GetAttachChildren();
+		if (!bMovable || Children.ContainsByPredicate([](const USceneComponent* Child) { return !Cast<USplineMeshComponent>(Child); })) continue;
+
+		FStrippedSpline& Stripped = StrippedSplines.AddDefaulted_GetRef();
+		Stripped.Spline = SplineComp;
+		for (USceneComponent* Child : TArray<USceneComponent*, TInlineAllocator<16>>(Children))
+		{
+			Stripped.Segments.Add(CastChecked<USplineMeshComponent>(Child));
+			Child->AttachToComponent(RootComp, FAttachmentTransformRules::KeepRelativeTransform);
+		}
+
+		Stats.NumSplines++;
+		Stats.NumSplinePoints += SplineComp->GetNumberOfSplinePoints();
+		Stats.SavedBytes += PowerlineCookStripper::GetSplineBytes(SplineComp);
+		SplineComp->bIsEditorOnly = true;
+	}
+
+	if (Stats.NumSplines > 0)
+	{
+		const ULevel* Level = Actor->GetLevel();
+		FPowerlineStripStats& Total = LevelStats.FindOrAdd(Level ? Level->GetPackage()->GetFName() : Actor->GetPackage()->GetFName());
+		Total.NumSplines += Stats.NumSplines;
+		Total.NumSplinePoints += Stats.NumSplinePoints;
+		Total.SavedBytes += Stats.SavedBytes;
+	}
+	return Stats.NumSplines;
+}
+
+void FPowerlineCookStripper::OnPackageSaved(const FString& Filename, UPackage* Package, FObjectPostSaveContext Context)
+{
+	if (!Context.IsCooking()) return;
+
+	// The editor keeps working with the same objects when cooking on the fly, so everything is put back as it was
+	for (int32 Index = StrippedSplines.Num() - 1; Index >= 0; Index--)
+	{
+		FStrippedSpline& Stripped = StrippedSplines[Index];
+		USplineComponent* SplineComp = Stripped.Spline.Get();
+		if (SplineComp && SplineComp->GetPackage() != Package) continue;
+
+		if (SplineComp)
+		{
+			SplineComp->bIsEditorOnly = false;
+			for (const TWeakObjectPtr<USplineMeshComponent>& Segment : Stripped.Segments)
+			{
+				if (Segment.IsValid())
+				{
+					Segment->AttachToComponent(SplineComp, FAttachmentTransformRules::KeepRelativeTransform);
+				}
+			}
+		}
+		StrippedSplines.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+void FPowerlineCookStripper::LogReport() const
+{
+	if (LevelStats.IsEmpty()) return;
+
+	FPowerlineStripStats Total;
+	for (const TPair<FName, FPowerlineStripStats>& Level : LevelStats)
+	{
+		UE_LOG(LogTemp, Display, TEXT("Powerline cook stripping %s: %d cable splines, %d points, %.1f KB saved"),
+			*Level.Key.ToString(), Level.Value.NumSplines, Level.Value.NumSplinePoints, Level.Value.SavedBytes / 1024.f);
+		Total.NumSplines += Level.Value.NumSplines;
+		Total.SavedBytes += Level.Value.SavedBytes;
+	}
+	UE_LOG(LogTemp, Display, TEXT("Powerline cook stripping: %d cable splines in %d levels, %.2f MB saved"),
+		Total.NumSplines, LevelStats.Num(), Total.SavedBytes / (1024.f * 1024.f));
+}
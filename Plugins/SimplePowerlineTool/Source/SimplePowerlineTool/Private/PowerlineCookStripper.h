@@ -0,0 +1,56 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPackage;
+class USplineComponent;
+class USplineMeshComponent;
+class FObjectPreSaveContext;
+class FObjectPostSaveContext;
+
+/** What stripping removed from the cooked cables of one level. */
+struct FPowerlineStripStats
+{
+	int32 NumSplines = 0;
+	int32 NumSplinePoints = 0;
+	int64 SavedBytes = 0;
+};
+
+/**
+ * Leaves the authoring splines of generated cables out of cooked packages. Spline mesh segments keep their
+ * own deformation, so they are moved onto the actor root for the save and the splines are marked editor only.
+ * The editor objects are put back once the package is saved, editor builds keep regenerating from the splines.
+ */
+class FPowerlineCookStripper
+{
+public:
+	/** Component tag of splines the generator creates, only those are stripped. */
+	static const FName CableSplineTag;
+
+	FPowerlineCookStripper();
+	~FPowerlineCookStripper();
+
+	/** Logs the memory saved per cooked level. */
+	void LogReport() const;
+
+private:
+	struct FStrippedSpline
+	{
+		TWeakObjectPtr<USplineComponent> Spline;
+		TArray<TWeakObjectPtr<USplineMeshComponent>, TInlineAllocator<16>> Segments;
+	};
+
+	void OnObjectPreSave(UObject* Object, FObjectPreSaveContext Context);
+	void OnPackageSaved(const FString& Filename, UPackage* Package, FObjectPostSaveContext Context);
+
+	/** Strips the cable splines of Actor for the save, returns the number of stripped splines. */
+	int32 StripActor(AActor* Actor);
+
+	TArray<FStrippedSpline> StrippedSplines;
+	TMap<FName, FPowerlineStripStats> LevelStats;
+
+	FDelegateHandle PreSaveHandle;
+	FDelegateHandle PackageSavedHandle;
+};
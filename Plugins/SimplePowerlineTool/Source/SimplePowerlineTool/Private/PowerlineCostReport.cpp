@@ -0,0 +1,351 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineCostReport.h"
+#include "PowerlineCableCollisionComponent.h"
+#include "PowerlineStreamingComponent.h"
+#include "PowerlineToolSettings.h"
+#include "PowerlineToolTypes.h"
+#include "EngineUtils.h"
+#include "Components/SplineComponent.h"
+#include "Components/SplineMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "StaticMeshResources.h"
+#include "UObject/Package.h"
+
+namespace PowerlineCostReport
+{
+	static constexpr int32 MaxLoggedActors = 50;
+
+	static int64 ToBytes(float Megabytes)
+	{
+		return static_cast<int64>(Megabytes * 1024.0 * 1024.0);
+	}
+
+	static float ToMegabytes(int64 Bytes)
+	{
+		return Bytes / (1024.f * 1024.f);
+	}
+
+	static FIntPoint GetCell(const FVector& Location, float CellSize)
+	{
+		return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+	}
+
+	/** Triangles and sections of the LOD a cable is seen at most of the time. */
+	static void GetMeshDrawCost(const UStaticMesh* Mesh, int64& OutTriangles, int32& OutDrawCalls)
+	{
+		OutTriangles = 0;
+		OutDrawCalls = 0;
+		const FStaticMeshRenderData* RenderData = Mesh ? Mesh->GetRenderData() : nullptr;
+		if (!RenderData || RenderData->LODResources.IsEmpty()) return;
+
+		const FStaticMeshLODResources& LOD = RenderData->LODResources[0];
+		OutTriangles = LOD.GetNumTriangles();
+		OutDrawCalls = LOD.Sections.Num();
+	}
+
+	/** Render side size of one spline mesh segment without its mesh, as AddActor measures spawned segments. */
+	static int64 GetSegmentRenderBytes()
+	{
+		return GetMutableDefault<USplineMeshComponent>()->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+
+	/**
+	 * What NumBodies capsule chain bodies with NumCapsules capsules in total measure, the way AddActor measures
+	 * UPowerlineCableCollisionComponent. Priced once from a probe body, a base per body plus a cost per capsule.
+	 */
+	static int64 GetCapsuleChainPhysicsBytes(int64 NumBodies, int64 NumCapsules)
+	{
+		static const TPair<int64, int64> BodyAndCapsuleBytes = []()
+			{
+				constexpr int32 NumProbeCapsules = 64;
+				UBodySetup* Probe = NewObject<UBodySetup>(GetTransientPackage(), NAME_None, RF_Transient);
+				Probe->CollisionTraceFlag = CTF_UseSimpleAsComplex;
+				Probe->bNeverNeedsCookedCollisionData = true;
+				const int64 EmptyBytes = Probe->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+				Probe->AggGeom.SphylElems.Reserve(NumProbeCapsules);
+				for (int32 Capsule = 0; Capsule < NumProbeCapsules; Capsule++)
+				{
+					Probe->AggGeom.SphylElems.Emplace(1.f, 100.f);
+				}
+				const int64 FullBytes = Probe->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+				Probe->MarkAsGarbage();
+				return TPair<int64, int64>(EmptyBytes, (FullBytes - EmptyBytes) / NumProbeCapsules);
+			}();
+		return NumBodies * BodyAndCapsuleBytes.Key + NumCapsules * BodyAndCapsuleBytes.Value;
+	}
+
+	/** Roughly what one spline mesh segment cooks when it keeps the mesh collision. */
+	static int64 GetSegmentPhysicsBytes(UStaticMesh* Mesh)
+	{
+		const UBodySetup* MeshBodySetup = Mesh ? Mesh->GetBodySetup() : nullptr;
+		return MeshBodySetup ? MeshBodySetup->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal) : 0;
+	}
+}
+
+FPowerlineCost& FPowerlineCost::operator+=(const FPowerlineCost& Other)
+{
+	NumActors += Other.NumActors;
+	NumComponents += Other.NumComponents;
+	NumSplineComponents += Other.NumSplineComponents;
+	NumSplineMeshComponents += Other.NumSplineMeshComponents;
+	NumSplinePoints += Other.NumSplinePoints;
+	NumStreamedSpans += Other.NumStreamedSpans;
+	RenderMemoryBytes += Other.RenderMemoryBytes;
+	PhysicsMemoryBytes += Other.PhysicsMemoryBytes;
+	PhysicsMemorySavedBytes += Other.PhysicsMemorySavedBytes;
+	NumTriangles += Other.NumTriangles;
+	NumDrawCalls += Other.NumDrawCalls;
+	return *this;
+}
+
+void FPowerlineCostAnalyzer::GatherWorld(UWorld* World, float CellSize, FPowerlineCostReport& OutReport)
+{
+	OutReport.CellSize = FMath::Max(CellSize, 1.f);
+	if (!World) return;
+
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AddActor(*It, OutReport);
+	}
+}
+
+bool FPowerlineCostAnalyzer::AddActor(AActor* Actor, FPowerlineCostReport& OutReport)
+{
+	if (!Actor) return false;
+
+	FPowerlineCost Cost;
+	bool bCableActor = false;
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		Cost.NumComponents++;
+		if (const USplineComponent* SplineComp = Cast<USplineComponent>(Component))
+		{
+			Cost.NumSplineComponents++;
+			Cost.NumSplinePoints += SplineComp->GetNumberOfSplinePoints();
+		}
+		else if (UPowerlineCableCollisionComponent* CollisionComp = Cast<UPowerlineCableCollisionComponent>(Component))
+		{
+			if (const UBodySetup* CapsuleBodySetup = CollisionComp->GetBodySetup())
+			{
+				Cost.PhysicsMemoryBytes += CapsuleBodySetup->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+			}
+		}
+		else if (const UPowerlineStreamingComponent* StreamingComp = Cast<UPowerlineStreamingComponent>(Component))
+		{
+			Cost.NumStreamedSpans += StreamingComp->GetSpans().Num();
+			bCableActor = true;
+		}
+		else if (const USplineMeshComponent* SplineMeshComp = Cast<USplineMeshComponent>(Component))
+		{
+			Cost.NumSplineMeshComponents++;
+			Cost.RenderMemoryBytes += SplineMeshComp->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+			// Spline meshes cook their own deformed collision, it is not shared with the mesh
+			UStaticMesh* Mesh = SplineMeshComp->GetStaticMesh();
+			if (SplineMeshComp->BodySetup)
+			{
+				Cost.PhysicsMemoryBytes += SplineMeshComp->BodySetup->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+			}
+			else if (!SplineMeshComp->IsCollisionEnabled())
+			{
+				Cost.PhysicsMemorySavedBytes += PowerlineCostReport::GetSegmentPhysicsBytes(Mesh);
+			}
+
+			int64 NumTriangles = 0;
+			int32 NumDrawCalls = 0;
+			PowerlineCostReport::GetMeshDrawCost(Mesh, NumTriangles, NumDrawCalls);
+			Cost.NumTriangles += NumTriangles;
+			Cost.NumDrawCalls += NumDrawCalls;
+
+			bool bAlreadyCounted = true;
+			OutReport.CountedMeshes.Add(FObjectKey(Mesh), &bAlreadyCounted);
+			if (Mesh && !bAlreadyCounted)
+			{
+				OutReport.Total.RenderMemoryBytes += Mesh->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+			}
+			bCableActor = true;
+		}
+	}
+	if (!bCableActor) return false;
+
+	Cost.NumActors = 1;
+	FPowerlineActorCost& ActorCost = OutReport.Actors.AddDefaulted_GetRef();
+	ActorCost.Actor = Actor;
+	ActorCost.Cost = Cost;
+
+	OutReport.Cells.FindOrAdd(PowerlineCostReport::GetCell(Actor->GetActorLocation(), OutReport.CellSize)) += Cost;
+	OutReport.Total += Cost;
+	return true;
+}
+
+FPowerlineCost FPowerlineCostAnalyzer::EstimateGeneration(int32 NumSpans, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, const FPowerlineCostReport* Report)
+{
+	FPowerlineCost Cost;
+	if (NumSpans <= 0) return Cost;
+
+	const int32 NumTracks = NumSpans * NumSocketsPerPole;
+	if (Settings.bRuntimeStreaming)
+	{
+		Cost.NumActors = 1;
+		Cost.NumComponents = 1;
+		Cost.NumStreamedSpans = NumTracks;
+		return Cost;
+	}
+
+	const int32 SpansPerActor = Settings.bContinuousCables ? FMath::Max(1, Settings.ContinuousSpansPerActor) : 1;
+	Cost.NumActors = FMath::DivideAndRoundUp(NumSpans, SpansPerActor);
+	Cost.NumSplineComponents = Cost.NumActors * NumSocketsPerPole;
+	Cost.NumSplineMeshComponents = NumTracks * Settings.SplineSegments;
+	Cost.NumSplinePoints = NumTracks * Settings.SplineSegments + Cost.NumSplineComponents;
+	Cost.NumComponents = Cost.NumActors * (Settings.bAddWindComponent ? 2 : 1) + Cost.NumSplineComponents + Cost.NumSplineMeshComponents;
+	Cost.RenderMemoryBytes = PowerlineCostReport::GetSegmentRenderBytes() * Cost.NumSplineMeshComponents;
+	if (Settings.CableMesh && (!Report || !Report->CountedMeshes.Contains(FObjectKey(Settings.CableMesh.Get()))))
+	{
+		Cost.RenderMemoryBytes += Settings.CableMesh->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	}
+
+	// Compact cables replace the splines with one component per actor
+	if (Settings.bCompactStorage && !Settings.bContinuousCables)
+	{
+		Cost.NumComponents += Cost.NumActors - Cost.NumSplineComponents;
+		Cost.NumSplineComponents = 0;
+		Cost.NumSplinePoints = 0;
+	}
+
+	int64 NumTriangles = 0;
+	int32 NumDrawCalls = 0;
+	PowerlineCostReport::GetMeshDrawCost(Settings.CableMesh, NumTriangles, NumDrawCalls);
+	Cost.NumTriangles = NumTriangles * Cost.NumSplineMeshComponents;
+	Cost.NumDrawCalls = NumDrawCalls * Cost.NumSplineMeshComponents;
+
+	// Per segment collision cooks a deformed copy of the mesh collision for every segment
+	const int64 PerSegmentPhysicsBytes = PowerlineCostReport::GetSegmentPhysicsBytes(Settings.CableMesh) * Cost.NumSplineMeshComponents;
+	switch (Settings.CollisionPolicy)
+	{
+	case EPowerlineCollisionPolicy::PerSegment:
+		Cost.PhysicsMemoryBytes = PerSegmentPhysicsBytes;
+		break;
+	case EPowerlineCollisionPolicy::CapsuleChain:
+		Cost.NumComponents += Cost.NumActors;
+		Cost.PhysicsMemoryBytes = PowerlineCostReport::GetCapsuleChainPhysicsBytes(Cost.NumActors, Cost.NumSplineMeshComponents);
+		Cost.PhysicsMemorySavedBytes = FMath::Max<int64>(0, PerSegmentPhysicsBytes - Cost.PhysicsMemoryBytes);
+		break;
+	default:
+		Cost.PhysicsMemorySavedBytes = PerSegmentPhysicsBytes;
+		break;
+	}
+	return Cost;
+}
+
+void FPowerlineCostAnalyzer::EstimateGenerationCells(TArrayView<const FVector> PoleLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, float CellSize, TMap<FIntPoint, FPowerlineCost>& OutCells)
+{
+	const int32 NumSpans = PoleLocations.Num() - 1;
+	if (NumSpans <= 0) return;
+
+	// Cells never hold the render data of the cable mesh, AddActor only adds it to the total
+	FPowerlineCostReport MeshCounted;
+	MeshCounted.CountedMeshes.Add(FObjectKey(Settings.CableMesh.Get()));
+
+	// Same chunks as generation, each actor sits at the first pole of its spans
+	const int32 SpansPerActor = Settings.bRuntimeStreaming ? NumSpans : Settings.bContinuousCables ? FMath::Max(1, Settings.ContinuousSpansPerActor) : 1;
+	for (int32 FirstPole = 0; FirstPole < NumSpans; FirstPole += SpansPerActor)
+	{
+		const int32 NumActorSpans = FMath::Min(SpansPerActor, NumSpans - FirstPole);
+		OutCells.FindOrAdd(PowerlineCostReport::GetCell(PoleLocations[FirstPole], FMath::Max(CellSize, 1.f)))
+			+= EstimateGeneration(NumActorSpans, NumSocketsPerPole, Settings, &MeshCounted);
+	}
+}
+
+void FPowerlineCostAnalyzer::CheckBudget(const FPowerlineCostReport& Report, const FPowerlineBudget& Budget, TArray<FString>& OutViolations, const FPowerlineCost& Planned, const TMap<FIntPoint, FPowerlineCost>* PlannedCells)
+{
+	FPowerlineCost Total = Report.Total;
+	Total += Planned;
+	if (Budget.MaxComponents > 0 && Total.NumComponents > Budget.MaxComponents)
+	{
+		OutViolations.Add(FString::Printf(TEXT("%d components, budget %d"), Total.NumComponents, Budget.MaxComponents));
+	}
+	if (Budget.MaxSplinePoints > 0 && Total.NumSplinePoints > Budget.MaxSplinePoints)
+	{
+		OutViolations.Add(FString::Printf(TEXT("%d spline points, budget %d"), Total.NumSplinePoints, Budget.MaxSplinePoints));
+	}
+	if (Budget.MaxRenderMemoryMB > 0.f && Total.RenderMemoryBytes > PowerlineCostReport::ToBytes(Budget.MaxRenderMemoryMB))
+	{
+		OutViolations.Add(FString::Printf(TEXT("%.2f MB render memory, budget %.2f MB"), PowerlineCostReport::ToMegabytes(Total.RenderMemoryBytes), Budget.MaxRenderMemoryMB));
+	}
+	if (Budget.MaxPhysicsMemoryMB > 0.f && Total.PhysicsMemoryBytes > PowerlineCostReport::ToBytes(Budget.MaxPhysicsMemoryMB))
+	{
+		OutViolations.Add(FString::Printf(TEXT("%.2f MB physics memory, budget %.2f MB"), PowerlineCostReport::ToMegabytes(Total.PhysicsMemoryBytes), Budget.MaxPhysicsMemoryMB));
+	}
+	if (Budget.MaxTriangles > 0 && Total.NumTriangles > Budget.MaxTriangles)
+	{
+		OutViolations.Add(FString::Printf(TEXT("%lld triangles, budget %lld"), Total.NumTriangles, Budget.MaxTriangles));
+	}
+	if (Budget.MaxDrawCalls > 0 && Total.NumDrawCalls > Budget.MaxDrawCalls)
+	{
+		OutViolations.Add(FString::Printf(TEXT("%d draw calls, budget %d"), Total.NumDrawCalls, Budget.MaxDrawCalls));
+	}
+	if (Budget.MaxDrawCallsPerCell > 0)
+	{
+		TMap<FIntPoint, FPowerlineCost> Cells = Report.Cells;
+		if (PlannedCells)
+		{
+			for (const TPair<FIntPoint, FPowerlineCost>& PlannedCell : *PlannedCells)
+			{
+				Cells.FindOrAdd(PlannedCell.Key) += PlannedCell.Value;
+			}
+		}
+		for (const TPair<FIntPoint, FPowerlineCost>& Cell : Cells)
+		{
+			if (Cell.Value.NumDrawCalls > Budget.MaxDrawCallsPerCell)
+			{
+				OutViolations.Add(FString::Printf(TEXT("%d draw calls in cell (%d, %d), budget %d"), Cell.Value.NumDrawCalls, Cell.Key.X, Cell.Key.Y, Budget.MaxDrawCallsPerCell));
+			}
+		}
+	}
+}
+
+void FPowerlineCostAnalyzer::LogReport(const FPowerlineCostReport& Report, const FPowerlineBudget& Budget)
+{
+	UE_LOG(LogTemp, Log, TEXT("Cable cost: %s"), *GetSummary(Report));
+
+	// Most expensive actors first, those are the ones worth looking at
+	TArray<const FPowerlineActorCost*> SortedActors;
+	SortedActors.Reserve(Report.Actors.Num());
+	for (const FPowerlineActorCost& ActorCost : Report.Actors)
+	{
+		SortedActors.Add(&ActorCost);
+	}
+	SortedActors.Sort([](const FPowerlineActorCost& A, const FPowerlineActorCost& B) { return A.Cost.NumDrawCalls > B.Cost.NumDrawCalls; });
+	for (int32 Index = 0; Index < FMath::Min(SortedActors.Num(), PowerlineCostReport::MaxLoggedActors); Index++)
+	{
+		const FPowerlineActorCost& ActorCost = *SortedActors[Index];
+		const AActor* Actor = ActorCost.Actor.Get();
+		UE_LOG(LogTemp, Log, TEXT("  %s: %d components, %d spline points, %lld triangles, %d draw calls, %.1f KB render, %.1f KB physics"),
+			Actor ? *Actor->GetActorNameOrLabel() : TEXT("<destroyed>"), ActorCost.Cost.NumComponents, ActorCost.Cost.NumSplinePoints, ActorCost.Cost.NumTriangles,
+			ActorCost.Cost.NumDrawCalls, ActorCost.Cost.RenderMemoryBytes / 1024.f, ActorCost.Cost.PhysicsMemoryBytes / 1024.f);
+	}
+
+	for (const TPair<FIntPoint, FPowerlineCost>& Cell : Report.Cells)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  Cell (%d, %d): %d actors, %d components, %lld triangles, %d draw calls, %.2f MB physics"),
+			Cell.Key.X, Cell.Key.Y, Cell.Value.NumActors, Cell.Value.NumComponents, Cell.Value.NumTriangles, Cell.Value.NumDrawCalls, PowerlineCostReport::ToMegabytes(Cell.Value.PhysicsMemoryBytes));
+	}
+
+	TArray<FString> Violations;
+	CheckBudget(Report, Budget, Violations);
+	for (const FString& Violation : Violations)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Cable budget exceeded: %s"), *Violation);
+	}
+}
+
+FString FPowerlineCostAnalyzer::GetSummary(const FPowerlineCostReport& Report)
+{
+	const FPowerlineCost& Total = Report.Total;
+	return FString::Printf(TEXT("%d actors, %d components, %d spline points, %d streamed spans, %lld triangles, %d draw calls, %.2f MB render, %.2f MB physics (%.2f MB saved by collision policy) in %d cells"),
+		Total.NumActors, Total.NumComponents, Total.NumSplinePoints, Total.NumStreamedSpans, Total.NumTriangles, Total.NumDrawCalls,
+		PowerlineCostReport::ToMegabytes(Total.RenderMemoryBytes), PowerlineCostReport::ToMegabytes(Total.PhysicsMemoryBytes),
+		PowerlineCostReport::ToMegabytes(Total.PhysicsMemorySavedBytes), Report.Cells.Num());
+}
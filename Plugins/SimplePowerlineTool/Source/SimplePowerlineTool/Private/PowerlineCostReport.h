@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+struct FPowerlineBudget;
+struct FPowerlineGenerationSettings;
+
+struct FPowerlineCost
+{
+	int32 NumActors = 0;
+	int32 NumComponents = 0;
+	int32 NumSplineComponents = 0;
+	int32 NumSplineMeshComponents = 0;
+	int32 NumSplinePoints = 0;
+
+	/** Spans kept as descriptors by streaming components, they cost no components until built at runtime. */
+	int32 NumStreamedSpans = 0;
+
+	int64 RenderMemoryBytes = 0;
+	int64 PhysicsMemoryBytes = 0;
+
+	/** Deformed per segment collision avoided by the collision policy, estimated from the cable mesh collision. */
+	int64 PhysicsMemorySavedBytes = 0;
+
+	int64 NumTriangles = 0;
+	int32 NumDrawCalls = 0;
+
+	FPowerlineCost& operator+=(const FPowerlineCost& Other);
+};
+
+struct FPowerlineActorCost
+{
+	TWeakObjectPtr<AActor> Actor;
+	FPowerlineCost Cost;
+};
+
+struct FPowerlineCostReport
+{
+	TArray<FPowerlineActorCost> Actors;
+
+	/** Costs grouped by the grid cell of each actor's location. */
+	TMap<FIntPoint, FPowerlineCost> Cells;
+	float CellSize = 25600.f;
+
+	/** Every actor plus the render data of each cable mesh, which all segments using it share. */
+	FPowerlineCost Total;
+
+	TSet<FObjectKey> CountedMeshes;
+};
+
+/** Tallies what generated cables cost in a level and checks it against FPowerlineBudget. */
+class FPowerlineCostAnalyzer
+{
+public:
+	static void GatherWorld(UWorld* World, float CellSize, FPowerlineCostReport& OutReport);
+
+	/** Adds Actor to the report when it owns cable components, returns whether it did. */
+	static bool AddActor(AActor* Actor, FPowerlineCostReport& OutReport);
+
+	/**
+	 * Cost of generating NumSpans spans with Settings before anything is spawned, measured the way AddActor measures spawned cables.
+	 * The render data of the cable mesh is included unless Report already counts it.
+	 */
+	static FPowerlineCost EstimateGeneration(int32 NumSpans, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, const FPowerlineCostReport* Report = nullptr);
+
+	/** Adds the estimated cost of every cable actor generated along PoleLocations to the cell AddActor will put it in. */
+	static void EstimateGenerationCells(TArrayView<const FVector> PoleLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, float CellSize, TMap<FIntPoint, FPowerlineCost>& OutCells);
+
+	/** Appends one line per exceeded limit by the report's total plus Planned, and by each cell plus PlannedCells. */
+	static void CheckBudget(const FPowerlineCostReport& Report, const FPowerlineBudget& Budget, TArray<FString>& OutViolations, const FPowerlineCost& Planned = FPowerlineCost(), const TMap<FIntPoint, FPowerlineCost>* PlannedCells = nullptr);
+
+	static void LogReport(const FPowerlineCostReport& Report, const FPowerlineBudget& Budget);
+
+	/** One line summary for the tool tab. */
+	static FString GetSummary(const FPowerlineCostReport& Report);
+};
@@ -0,0 +1,524 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineExporter.h"
+#include "PowerlineCableMath.h"
+#include "PowerlineCompactCableComponent.h"
+#include "PowerlineNetworkGraph.h"
+#include "PowerlineStreamingComponent.h"
+#include "Components/SplineComponent.h"
+#include "Components/SplineMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "StaticMeshResources.h"
+
+namespace PowerlineExporter
+{
+	/** Centimeters, Z up, left handed to meters, Y up, right handed. Swapping two axes mirrors, so winding flips too. */
+	static FVector3f ToExportSpace(const FVector& Location)
+	{
+		return FVector3f(Location.X, Location.Z, Location.Y) * 0.01f;
+	}
+
+	/** Streams OBJ text through a buffer of ChunkBytes. */
+	class FObjWriter : public FPowerlineExportWriter
+	{
+	public:
+		FObjWriter(FArchive* InFile, int32 InChunkBytes)
+			: File(InFile), ChunkBytes(InChunkBytes)
+		{
+			Buffer.Reserve(ChunkBytes + 1024);
+			Append("# Powerline cables, meters, Y up\n");
+		}
+
+		virtual void BeginObject(const FString& Name) override
+		{
+			Append("o ");
+			Append(TCHAR_TO_UTF8(*Name));
+			Append("\n");
+		}
+
+		virtual void AddTriangles(TConstArrayView<FVector3f> Positions, TConstArrayView<uint32> Indices) override
+		{
+			const int64 FirstVertex = NumVertices + 1;
+			for (const FVector3f& Position : Positions)
+			{
+				AppendVertex(Position);
+			}
+			for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+			{
+				ANSICHAR Line[96];
+				const int32 Length = FCStringAnsi::Snprintf(Line, sizeof(Line), "f %lld %lld %lld\n",
+					FirstVertex + Indices[Index], FirstVertex + Indices[Index + 2], FirstVertex + Indices[Index + 1]);
+				AppendLine(Line, Length);
+			}
+			Stats.NumTriangles += Indices.Num() / 3;
+		}
+
+		virtual void AddLineStrip(TConstArrayView<FVector> Points) override
+		{
+			if (Points.Num() < 2) return;
+
+			const int64 FirstVertex = NumVertices + 1;
+			for (const FVector& Point : Points)
+			{
+				AppendVertex(ToExportSpace(Point));
+			}
+			Append("l");
+			for (int32 Point = 0; Point < Points.Num(); Point++)
+			{
+				ANSICHAR Index[24];
+				const int32 Length = FCStringAnsi::Snprintf(Index, sizeof(Index), " %lld", FirstVertex + Point);
+				AppendLine(Index, Length);
+			}
+			Append("\n");
+			Stats.NumLines += Points.Num() - 1;
+		}
+
+		virtual void AddPoint(const FVector& Point) override
+		{
+			AppendVertex(ToExportSpace(Point));
+			ANSICHAR Line[32];
+			const int32 Length = FCStringAnsi::Snprintf(Line, sizeof(Line), "p %lld\n", NumVertices);
+			AppendLine(Line, Length);
+			Stats.NumEndpoints++;
+		}
+
+		virtual bool Close(FPowerlineExportStats& OutStats) override
+		{
+			Flush();
+			const bool bSuccess = !File->IsError() && File->Close();
+			OutStats.NumVertices = NumVertices;
+			OutStats.NumTriangles = Stats.NumTriangles;
+			OutStats.NumLines = Stats.NumLines;
+			OutStats.NumEndpoints = Stats.NumEndpoints;
+			OutStats.NumBytes = Stats.NumBytes;
+			return bSuccess;
+		}
+
+	private:
+		void AppendVertex(const FVector3f& Position)
+		{
+			ANSICHAR Line[96];
+			const int32 Length = FCStringAnsi::Snprintf(Line, sizeof(Line), "v %.4f %.4f %.4f\n", Position.X, Position.Y, Position.Z);
+			AppendLine(Line, Length);
+			NumVertices++;
+		}
+
+		void Append(const ANSICHAR* Text)
+		{
+			AppendLine(Text, FCStringAnsi::Strlen(Text));
+		}
+
+		void AppendLine(const ANSICHAR* Text, int32 Length)
+		{
+			Buffer.Append(Text, Length);
+			if (Buffer.Num() >= ChunkBytes)
+			{
+				Flush();
+			}
+		}
+
+		void Flush()
+		{
+			if (Buffer.IsEmpty()) return;
+
+			File->Serialize(Buffer.GetData(), Buffer.Num());
+			Stats.NumBytes += Buffer.Num();
+			Buffer.Reset();
+		}
+
+		TUniquePtr<FArchive> File;
+		int32 ChunkBytes = 0;
+		TArray<ANSICHAR> Buffer;
+		int64 NumVertices = 0;
+		FPowerlineExportStats Stats;
+	};
+
+	/**
+	 * Streams glTF geometry into a .bin one primitive per chunk, the .gltf JSON only describes the chunks
+	 * and is written when closing. Cables are one mesh of triangle and line primitives, endpoints another.
+	 */
+	class FGltfWriter : public FPowerlineExportWriter
+	{
+	public:
+		FGltfWriter(FArchive* InBinFile, const FString& InFilename, const FString& InBinFilename, int32 ChunkBytes)
+			: BinFile(InBinFile), Filename(InFilename), BinFilename(InBinFilename)
+		{
+			// Positions and indices of a chunk together stay below ChunkBytes
+			MaxBatchBytes = FMath::Max(ChunkBytes, 1024);
+			Triangles.Mode = 4;
+			Lines.Mode = 1;
+			Points.Mode = 0;
+		}
+
+		virtual void AddTriangles(TConstArrayView<FVector3f> Positions, TConstArrayView<uint32> Indices) override
+		{
+			Reserve(Triangles, Positions.Num(), Indices.Num());
+			const uint32 FirstVertex = Triangles.Positions.Num();
+			for (const FVector3f& Position : Positions)
+			{
+				Triangles.Add(Position);
+			}
+			for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+			{
+				Triangles.Indices.Add(FirstVertex + Indices[Index]);
+				Triangles.Indices.Add(FirstVertex + Indices[Index + 2]);
+				Triangles.Indices.Add(FirstVertex + Indices[Index + 1]);
+			}
+			Stats.NumTriangles += Indices.Num() / 3;
+		}
+
+		virtual void AddLineStrip(TConstArrayView<FVector> InPoints) override
+		{
+			if (InPoints.Num() < 2) return;
+
+			Reserve(Lines, InPoints.Num(), (InPoints.Num() - 1) * 2);
+			const uint32 FirstVertex = Lines.Positions.Num();
+			for (int32 Point = 0; Point < InPoints.Num(); Point++)
+			{
+				Lines.Add(ToExportSpace(InPoints[Point]));
+				if (Point > 0)
+				{
+					Lines.Indices.Add(FirstVertex + Point - 1);
+					Lines.Indices.Add(FirstVertex + Point);
+				}
+			}
+			Stats.NumLines += InPoints.Num() - 1;
+		}
+
+		virtual void AddPoint(const FVector& Point) override
+		{
+			Reserve(Points, 1, 1);
+			Points.Indices.Add(Points.Positions.Num());
+			Points.Add(ToExportSpace(Point));
+			Stats.NumEndpoints++;
+		}
+
+		virtual bool Close(FPowerlineExportStats& OutStats) override
+		{
+			FlushBatch(Triangles, CablePrimitives);
+			FlushBatch(Lines, CablePrimitives);
+			FlushBatch(Points, EndpointPrimitives);
+			bool bSuccess = !BinFile->IsError() && BinFile->Close();
+
+			TArray<FString> Meshes;
+			TArray<FString> Nodes;
+			if (!CablePrimitives.IsEmpty())
+			{
+				Nodes.Add(FString::Printf(TEXT("{\"name\":\"Cables\",\"mesh\":%d}"), Meshes.Num()));
+				Meshes.Add(FString::Printf(TEXT("{\"name\":\"Cables\",\"primitives\":[%s]}"), *FString::Join(CablePrimitives, TEXT(","))));
+			}
+			if (!EndpointPrimitives.IsEmpty())
+			{
+				Nodes.Add(FString::Printf(TEXT("{\"name\":\"Endpoints\",\"mesh\":%d}"), Meshes.Num()));
+				Meshes.Add(FString::Printf(TEXT("{\"name\":\"Endpoints\",\"primitives\":[%s]}"), *FString::Join(EndpointPrimitives, TEXT(","))));
+			}
+
+			TArray<FString> NodeIndices;
+			for (int32 Node = 0; Node < Nodes.Num(); Node++)
+			{
+				NodeIndices.Add(FString::FromInt(Node));
+			}
+
+			FString Json = TEXT("{\"asset\":{\"version\":\"2.0\",\"generator\":\"SimplePowerlineTool\"},\"scene\":0,");
+			Json += FString::Printf(TEXT("\"scenes\":[{\"nodes\":[%s]}],"), *FString::Join(NodeIndices, TEXT(",")));
+			Json += FString::Printf(TEXT("\"nodes\":[%s],"), *FString::Join(Nodes, TEXT(",")));
+			Json += FString::Printf(TEXT("\"meshes\":[%s],"), *FString::Join(Meshes, TEXT(",")));
+			Json += FString::Printf(TEXT("\"accessors\":[%s],"), *FString::Join(Accessors, TEXT(",")));
+			Json += FString::Printf(TEXT("\"bufferViews\":[%s],"), *FString::Join(BufferViews, TEXT(",")));
+			Json += FString::Printf(TEXT("\"buffers\":[{\"uri\":\"%s\",\"byteLength\":%lld}]}"), *FPaths::GetCleanFilename(BinFilename), BinBytes);
+			bSuccess &= FFileHelper::SaveStringToFile(Json, *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+
+			OutStats.NumVertices = Stats.NumVertices;
+			OutStats.NumTriangles = Stats.NumTriangles;
+			OutStats.NumLines = Stats.NumLines;
+			OutStats.NumEndpoints = Stats.NumEndpoints;
+			OutStats.NumBytes = BinBytes + Json.Len();
+			return bSuccess;
+		}
+
+	private:
+		struct FBatch
+		{
+			TArray<FVector3f> Positions;
+			TArray<uint32> Indices;
+			FBox3f Bounds = FBox3f(ForceInit);
+			int32 Mode = 0;
+
+			void Add(const FVector3f& Position)
+			{
+				Positions.Add(Position);
+				Bounds += Position;
+			}
+		};
+
+		/** Flushes Batch first when the new geometry would make it exceed MaxBatchBytes. */
+		void Reserve(FBatch& Batch, int32 NumPositions, int32 NumIndices)
+		{
+			const int64 BatchBytes = (Batch.Positions.Num() + NumPositions) * sizeof(FVector3f) + (Batch.Indices.Num() + NumIndices) * sizeof(uint32);
+			if (BatchBytes > MaxBatchBytes && !Batch.Positions.IsEmpty())
+			{
+				FlushBatch(Batch, &Batch == &Points ? EndpointPrimitives : CablePrimitives);
+			}
+		}
+
+		int32 WriteBufferView(const void* Data, int64 NumBytes, int32 Target)
+		{
+			BinFile->Serialize(const_cast<void*>(Data), NumBytes);
+			BufferViews.Add(FString::Printf(TEXT("{\"buffer\":0,\"byteOffset\":%lld,\"byteLength\":%lld,\"target\":%d}"), BinBytes, NumBytes, Target));
+			BinBytes += NumBytes;
+			return BufferViews.Num() - 1;
+		}
+
+		void FlushBatch(FBatch& Batch, TArray<FString>& OutPrimitives)
+		{
+			if (Batch.Positions.IsEmpty()) return;
+
+			// Both element types are 4 byte aligned, so every view starts aligned without padding
+			const int32 PositionView = WriteBufferView(Batch.Positions.GetData(), Batch.Positions.Num() * sizeof(FVector3f), 34962);
+			Accessors.Add(FString::Printf(TEXT("{\"bufferView\":%d,\"componentType\":5126,\"count\":%d,\"type\":\"VEC3\",\"min\":[%f,%f,%f],\"max\":[%f,%f,%f]}"),
+				PositionView, Batch.Positions.Num(), Batch.Bounds.Min.X, Batch.Bounds.Min.Y, Batch.Bounds.Min.Z, Batch.Bounds.Max.X, Batch.Bounds.Max.Y, Batch.Bounds.Max.Z));
+			const int32 PositionAccessor = Accessors.Num() - 1;
+
+			const int32 IndexView = WriteBufferView(Batch.Indices.GetData(), Batch.Indices.Num() * sizeof(uint32), 34963);
+			Accessors.Add(FString::Printf(TEXT("{\"bufferView\":%d,\"componentType\":5125,\"count\":%d,\"type\":\"SCALAR\"}"), IndexView, Batch.Indices.Num()));
+
+			OutPrimitives.Add(FString::Printf(TEXT("{\"attributes\":{\"POSITION\":%d},\"indices\":%d,\"mode\":%d}"), PositionAccessor, Accessors.Num() - 1, Batch.Mode));
+			Stats.NumVertices += Batch.Positions.Num();
+			Batch.Positions.Reset();
+			Batch.Indices.Reset();
+			Batch.Bounds = FBox3f(ForceInit);
+		}
+
+		TUniquePtr<FArchive> BinFile;
+		FString Filename;
+		FString BinFilename;
+		int64 MaxBatchBytes = 0;
+		int64 BinBytes = 0;
+
+		FBatch Triangles;
+		FBatch Lines;
+		FBatch Points;
+
+		TArray<FString> BufferViews;
+		TArray<FString> Accessors;
+		TArray<FString> CablePrimitives;
+		TArray<FString> EndpointPrimitives;
+		FPowerlineExportStats Stats;
+	};
+}
+
+FPowerlineExporter::FPowerlineExporter(const FString& InFilename, const FPowerlineExportOptions& InOptions)
+	: Options(InOptions)
+{
+	StartTime = FPlatformTime::Seconds();
+	Writer = CreateWriter(InFilename, Options);
+}
+
+FPowerlineExporter::~FPowerlineExporter() = default;
+
+EPowerlineExportFormat FPowerlineExporter::GetFormatFromFilename(const FString& Filename)
+{
+	return FPaths::GetExtension(Filename).Equals(TEXT("gltf"), ESearchCase::IgnoreCase) ? EPowerlineExportFormat::Gltf : EPowerlineExportFormat::Obj;
+}
+
+TUniquePtr<FPowerlineExportWriter> FPowerlineExporter::CreateWriter(const FString& Filename, const FPowerlineExportOptions& Options)
+{
+	if (Options.Format == EPowerlineExportFormat::Gltf)
+	{
+		const FString BinFilename = FPaths::ChangeExtension(Filename, TEXT("bin"));
+		FArchive* BinFile = IFileManager::Get().CreateFileWriter(*BinFilename);
+		if (!BinFile) return nullptr;
+
+		return MakeUnique<PowerlineExporter::FGltfWriter>(BinFile, Filename, BinFilename, Options.ChunkBytes);
+	}
+
+	FArchive* File = IFileManager::Get().CreateFileWriter(*Filename);
+	if (!File) return nullptr;
+
+	return MakeUnique<PowerlineExporter::FObjWriter>(File, Options.ChunkBytes);
+}
+
+bool FPowerlineExporter::AddActor(AActor* Actor)
+{
+	if (!Actor || !Writer) return false;
+
+	TInlineComponentArray<USplineMeshComponent*> SplineMeshes(Actor);
+	TInlineComponentArray<UPowerlineCompactCableComponent*> CompactComps(Actor);
+	TInlineComponentArray<UPowerlineStreamingComponent*> StreamingComps(Actor);
+	if (SplineMeshes.IsEmpty() && CompactComps.IsEmpty() && StreamingComps.IsEmpty()) return false;
+
+	Writer->BeginObject(Actor->GetActorNameOrLabel());
+	NumActors++;
+
+	// Streaming spans have no components outside of play, they are always written as centre lines
+	for (const UPowerlineStreamingComponent* StreamingComp : StreamingComps)
+	{
+		const FTransform& ComponentTransform = StreamingComp->GetComponentTransform();
+		for (const FPowerlineSpanDescriptor& Span : StreamingComp->GetSpans())
+		{
+			const FVector SpanStart = ComponentTransform.TransformPosition(FVector(Span.Start));
+			const FVector SpanEnd = ComponentTransform.TransformPosition(FVector(Span.End));
+			Points.SetNumUninitialized(Span.NumSegments + 1);
+			FPowerlineCableMath::ComputeSpanPoints(SpanStart, SpanEnd, Span.Sag, Span.NumSegments, Points);
+			Writer->AddLineStrip(Points);
+			AddCableEnds(SpanStart, SpanEnd);
+		}
+	}
+
+	for (const UPowerlineCompactCableComponent* CompactComp : CompactComps)
+	{
+		const FTransform& ComponentTransform = CompactComp->GetComponentTransform();
+		for (const FPowerlineCompactCable& Cable : CompactComp->GetCables())
+		{
+			Points.SetNumUninitialized(Cable.GetNumPoints());
+			Cable.Decode(Points);
+			for (FVector& Point : Points)
+			{
+				Point = ComponentTransform.TransformPosition(Point);
+			}
+			AddCableEnds(Points[0], Points.Last());
+			if (Options.bCenterlines)
+			{
+				Writer->AddLineStrip(Points);
+			}
+		}
+	}
+
+	if (Options.bCenterlines || Options.bEndpoints)
+	{
+		TInlineComponentArray<USplineComponent*> Splines(Actor);
+		for (const USplineComponent* SplineComp : Splines)
+		{
+			const int32 NumPoints = SplineComp->GetNumberOfSplinePoints();
+			if (NumPoints < 2) continue;
+
+			Points.SetNumUninitialized(NumPoints);
+			for (int32 Point = 0; Point < NumPoints; Point++)
+			{
+				Points[Point] = SplineComp->GetLocationAtSplinePoint(Point, ESplineCoordinateSpace::World);
+			}
+			AddCableEnds(Points[0], Points.Last());
+			if (Options.bCenterlines)
+			{
+				Writer->AddLineStrip(Points);
+			}
+		}
+	}
+	if (Options.bCenterlines) return true;
+
+	// Segments of compact cables are components too, so every cable with a mesh is written here
+	for (const USplineMeshComponent* SplineMeshComp : SplineMeshes)
+	{
+		if (const FMeshSource* Source = GetMeshSource(SplineMeshComp))
+		{
+			AddSegmentMesh(SplineMeshComp, *Source);
+			continue;
+		}
+
+		const FTransform& ComponentTransform = SplineMeshComp->GetComponentTransform();
+		Points.Reset();
+		Points.Add(ComponentTransform.TransformPosition(SplineMeshComp->GetStartPosition()));
+		Points.Add(ComponentTransform.TransformPosition(SplineMeshComp->GetEndPosition()));
+		Writer->AddLineStrip(Points);
+	}
+	return true;
+}
+
+void FPowerlineExporter::AddCableEnds(const FVector& Start, const FVector& End)
+{
+	if (!Options.bEndpoints) return;
+
+	Writer->AddPoint(Start);
+	Writer->AddPoint(End);
+}
+
+void FPowerlineExporter::AddGraphPoles(const UPowerlineNetworkGraph* Graph)
+{
+	if (!Graph || !Writer || !Options.bEndpoints) return;
+
+	Writer->BeginObject(TEXT("Poles"));
+	for (int32 Pole = 0; Pole < Graph->GetNumPoles(); Pole++)
+	{
+		Writer->AddPoint(Graph->GetPole(Pole).Location);
+	}
+}
+
+const FPowerlineExporter::FMeshSource* FPowerlineExporter::GetMeshSource(const USplineMeshComponent* SplineMeshComp)
+{
+	const UStaticMesh* Mesh = SplineMeshComp->GetStaticMesh();
+	if (!Mesh) return nullptr;
+
+	const ESplineMeshAxis::Type ForwardAxis = SplineMeshComp->ForwardAxis;
+	const TPair<const UStaticMesh*, int32> Key(Mesh, ForwardAxis);
+	if (const TUniquePtr<FMeshSource>* Found = MeshSources.Find(Key))
+	{
+		return Found->Get();
+	}
+
+	// Cached as null too, so an unreadable mesh is only checked once
+	TUniquePtr<FMeshSource>& Source = MeshSources.Add(Key);
+	const FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
+	if (!RenderData || RenderData->LODResources.IsEmpty()) return nullptr;
+
+	const FStaticMeshLODResources& LOD = RenderData->LODResources[0];
+	const FPositionVertexBuffer& PositionBuffer = LOD.VertexBuffers.PositionVertexBuffer;
+	if (!PositionBuffer.GetVertexData() || PositionBuffer.GetNumVertices() == 0) return nullptr;
+
+	// Vertices of a cable mesh sit in rings along the forward axis, the slice transform is then computed once per ring
+	Source = MakeUnique<FMeshSource>();
+	TMap<float, int32> SliceLookup;
+	Source->SlicePositions.SetNumUninitialized(PositionBuffer.GetNumVertices());
+	Source->VertexSlices.SetNumUninitialized(PositionBuffer.GetNumVertices());
+	for (uint32 Vertex = 0; Vertex < PositionBuffer.GetNumVertices(); Vertex++)
+	{
+		FVector3f Position = PositionBuffer.VertexPosition(Vertex);
+		float& AxisValue = USplineMeshComponent::GetAxisValueRef(Position, ForwardAxis);
+		int32& Slice = SliceLookup.FindOrAdd(AxisValue, INDEX_NONE);
+		if (Slice == INDEX_NONE)
+		{
+			Slice = Source->SliceDistances.Add(AxisValue);
+		}
+		AxisValue = 0.f;
+		Source->SlicePositions[Vertex] = Position;
+		Source->VertexSlices[Vertex] = Slice;
+	}
+
+	Source->Indices.SetNumUninitialized(LOD.IndexBuffer.GetNumIndices());
+	for (int32 Index = 0; Index < Source->Indices.Num(); Index++)
+	{
+		Source->Indices[Index] = LOD.IndexBuffer.GetIndex(Index);
+	}
+	return Source.Get();
+}
+
+void FPowerlineExporter::AddSegmentMesh(const USplineMeshComponent* SplineMeshComp, const FMeshSource& Source)
+{
+	const FTransform& ComponentTransform = SplineMeshComp->GetComponentTransform();
+	SliceTransforms.SetNumUninitialized(Source.SliceDistances.Num());
+	for (int32 Slice = 0; Slice < Source.SliceDistances.Num(); Slice++)
+	{
+		SliceTransforms[Slice] = SplineMeshComp->CalcSliceTransform(Source.SliceDistances[Slice]) * ComponentTransform;
+	}
+
+	Positions.SetNumUninitialized(Source.SlicePositions.Num());
+	for (int32 Vertex = 0; Vertex < Positions.Num(); Vertex++)
+	{
+		const FVector Location = SliceTransforms[Source.VertexSlices[Vertex]].TransformPosition(FVector(Source.SlicePositions[Vertex]));
+		Positions[Vertex] = PowerlineExporter::ToExportSpace(Location);
+	}
+	Writer->AddTriangles(Positions, Source.Indices);
+}
+
+bool FPowerlineExporter::Finish(FPowerlineExportStats& OutStats)
+{
+	if (!Writer) return false;
+
+	const bool bSuccess = Writer->Close(OutStats);
+	Writer.Reset();
+	OutStats.NumActors = NumActors;
+	OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+	return bSuccess;
+}
@@ -0,0 +1,112 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FArchive;
+class UPowerlineNetworkGraph;
+class UStaticMesh;
+class USplineMeshComponent;
+
+enum class EPowerlineExportFormat : uint8
+{
+	Obj,
+	/** .gltf with its geometry in a .bin next to it. */
+	Gltf,
+};
+
+struct FPowerlineExportOptions
+{
+	EPowerlineExportFormat Format = EPowerlineExportFormat::Obj;
+
+	/** Cable centre lines as line strips instead of the deformed cable mesh of every segment. */
+	bool bCenterlines = false;
+
+	/** Span ends and network graph poles as points. */
+	bool bEndpoints = true;
+
+	/** Size of the buffered output, or of one glTF primitive, before it is written out. */
+	int32 ChunkBytes = 1 << 20;
+};
+
+struct FPowerlineExportStats
+{
+	int32 NumActors = 0;
+	int64 NumVertices = 0;
+	int64 NumTriangles = 0;
+	int64 NumLines = 0;
+	int64 NumEndpoints = 0;
+	int64 NumBytes = 0;
+	double Seconds = 0.0;
+};
+
+/** Receives geometry in world space and streams it to a file in chunks. */
+class FPowerlineExportWriter
+{
+public:
+	virtual ~FPowerlineExportWriter() = default;
+
+	/** Starts a named group, OBJ objects are per cable actor. */
+	virtual void BeginObject(const FString& Name) {}
+	virtual void AddTriangles(TConstArrayView<FVector3f> Positions, TConstArrayView<uint32> Indices) = 0;
+	virtual void AddLineStrip(TConstArrayView<FVector> Points) = 0;
+	virtual void AddPoint(const FVector& Point) = 0;
+
+	/** Writes what is still buffered, returns false when a file could not be written. */
+	virtual bool Close(FPowerlineExportStats& OutStats) = 0;
+};
+
+/**
+ * Writes the generated cables of a world and their endpoints to OBJ or glTF. Cables are converted one actor
+ * at a time and flushed in chunks, so memory stays bounded by the chunk size however large the network is.
+ * Output is in meters, Y up and right handed, as both formats expect.
+ */
+class FPowerlineExporter
+{
+public:
+	FPowerlineExporter(const FString& InFilename, const FPowerlineExportOptions& InOptions);
+	~FPowerlineExporter();
+
+	/** Format matching the extension of Filename, OBJ when it is not .gltf. */
+	static EPowerlineExportFormat GetFormatFromFilename(const FString& Filename);
+
+	static TUniquePtr<FPowerlineExportWriter> CreateWriter(const FString& Filename, const FPowerlineExportOptions& Options);
+
+	bool IsValid() const { return Writer.IsValid(); }
+
+	/** Writes Actor when it owns cable components, returns whether it did. */
+	bool AddActor(AActor* Actor);
+
+	/** Pole locations of Graph as endpoints, for the poles continuous cables pass without ending. */
+	void AddGraphPoles(const UPowerlineNetworkGraph* Graph);
+
+	bool Finish(FPowerlineExportStats& OutStats);
+
+private:
+	/** LOD 0 of a cable mesh split into slices along the forward axis, shared by every segment using it. */
+	struct FMeshSource
+	{
+		TArray<FVector3f> SlicePositions;
+		TArray<int32> VertexSlices;
+		TArray<float> SliceDistances;
+		TArray<uint32> Indices;
+	};
+
+	/** Null when the mesh has no CPU readable vertices, the segment is exported as its centre line then. */
+	const FMeshSource* GetMeshSource(const USplineMeshComponent* SplineMeshComp);
+	void AddSegmentMesh(const USplineMeshComponent* SplineMeshComp, const FMeshSource& Source);
+	void AddCableEnds(const FVector& Start, const FVector& End);
+
+	FPowerlineExportOptions Options;
+	TUniquePtr<FPowerlineExportWriter> Writer;
+	/** Keyed by mesh and forward axis. */
+	TMap<TPair<const UStaticMesh*, int32>, TUniquePtr<FMeshSource>> MeshSources;
+	int32 NumActors = 0;
+	double StartTime = 0.0;
+
+	/** Reused between segments. */
+	TArray<FVector3f> Positions;
+	TArray<FTransform> SliceTransforms;
+	TArray<FVector> Points;
+};
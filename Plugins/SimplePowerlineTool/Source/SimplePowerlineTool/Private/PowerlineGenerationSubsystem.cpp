@@ -0,0 +1,1660 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineGenerationSubsystem.h"
+#include "PowerlineCableCollisionComponent.h"
+#include "PowerlineCableMath.h"
+#include "PowerlineCompactCableComponent.h"
+#include "PowerlineCookStripper.h"
+#include "PowerlineCostReport.h"
+#include "PowerlineNetworkGraph.h"
+#include "PowerlineRuntimeUtils.h"
+#include "PowerlineStreamingComponent.h"
+#include "PowerlineToolSettings.h"
+#include "PowerlineWindComponent.h"
+#include "Editor.h"
+#include "ScopedTransaction.h"
+#include "Engine/Selection.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshSocket.h"
+#include "Components/SplineComponent.h"
+#include "Components/SplineMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Async/ParallelFor.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "WorldPartition/WorldPartition.h"
+
+namespace PowerlineGenerationSubsystem
+{
+	/** Marks the splines of continuous cables, their span boundaries can only be found through the network graph. */
+	static const FName ContinuousCableTag(TEXT("PowerlineContinuousCable"));
+
+	using FSplineSegments = TArray<USplineMeshComponent*, TInlineAllocator<16>>;
+
+	/**
+	 * Segments of every spline of CableActor in cable order. Segments are attached to their spline,
+	 * cables generated before that have them on the root right after their spline in component order.
+	 */
+	static void GetSplineSegments(AActor* CableActor, TArray<TPair<USplineComponent*, FSplineSegments>>& OutSplines)
+	{
+		OutSplines.Reset();
+		USplineComponent* OrderedSpline = nullptr;
+		for (UActorComponent* Component : CableActor->GetComponents())
+		{
+			if (USplineComponent* SplineComp = Cast<USplineComponent>(Component))
+			{
+				FSplineSegments& Segments = OutSplines.Emplace_GetRef(SplineComp, FSplineSegments()).Value;
+				for (USceneComponent* Child : SplineComp->GetAttachChildren())
+				{
+					if (USplineMeshComponent* Segment = Cast<USplineMeshComponent>(Child))
+					{
+						Segments.Add(Segment);
+					}
+				}
+				OrderedSpline = Segments.IsEmpty() ? SplineComp : nullptr;
+				continue;
+			}
+
+			USplineMeshComponent* Segment = Cast<USplineMeshComponent>(Component);
+			if (OrderedSpline && Segment && Segment->GetAttachParent() == CableActor->GetRootComponent() && OutSplines.Last().Value.Num() < OrderedSpline->GetNumberOfSplinePoints() - 1)
+			{
+				OutSplines.Last().Value.Add(Segment);
+			}
+		}
+	}
+
+	/** Replaces the points of SplineComp with Points in its local space, same layout as generated splines. */
+	static void SetLocalSplinePoints(USplineComponent* SplineComp, TConstArrayView<FVector> Points)
+	{
+		FSplineCurves& Curves = SplineComp->SplineCurves;
+		Curves.Position.Points.Reset(Points.Num());
+		Curves.Rotation.Points.Reset(Points.Num());
+		Curves.Scale.Points.Reset(Points.Num());
+		for (int32 Point = 0; Point < Points.Num(); Point++)
+		{
+			const float InputKey = static_cast<float>(Point);
+			Curves.Position.Points.Emplace(InputKey, Points[Point], FVector::ZeroVector, FVector::ZeroVector, CIM_CurveAuto);
+			Curves.Rotation.Points.Emplace(InputKey, FQuat::Identity, FQuat::Identity, FQuat::Identity, CIM_CurveAuto);
+			Curves.Scale.Points.Emplace(InputKey, FVector::OneVector, FVector::ZeroVector, FVector::ZeroVector, CIM_CurveAuto);
+		}
+		SplineComp->UpdateSpline();
+	}
+
+	/** One spline or compact cable of ApplyParameters, gathered on the game thread and reshaped in parallel. */
+	struct FCableReshape
+	{
+		AActor* CableActor = nullptr;
+		USplineComponent* Spline = nullptr;
+		UPowerlineCompactCableComponent* Compact = nullptr;
+		int32 CompactCable = INDEX_NONE;
+		FSplineSegments Segments;
+		FTransform ComponentTransform;
+
+		/** World space ends of the spans along the cable, one more than Sags. */
+		TArray<FVector, TInlineAllocator<4>> SpanEnds;
+		TArray<float, TInlineAllocator<4>> Sags;
+		TArray<int32, TInlineAllocator<4>> GraphSpans;
+
+		/** Component space. */
+		TArray<FVector, TInlineAllocator<32>> Points;
+		TArray<FVector, TInlineAllocator<32>> Tangents;
+	};
+
+	/** Mesh a cable component is indexed under, null for components that are not cables. */
+	static UStaticMesh* GetIndexedCableMesh(const UActorComponent* Component)
+	{
+		if (const USplineMeshComponent* Segment = Cast<USplineMeshComponent>(Component)) return Segment->GetStaticMesh();
+		if (const UPowerlineCompactCableComponent* CompactComp = Cast<UPowerlineCompactCableComponent>(Component)) return CompactComp->CableMesh;
+		if (const UPowerlineStreamingComponent* StreamingComp = Cast<UPowerlineStreamingComponent>(Component)) return StreamingComp->CableMesh;
+		return nullptr;
+	}
+
+	/** Whether Actor carries anything the cost report counts. */
+	static bool HasCableComponents(const AActor* Actor)
+	{
+		return Actor && (Actor->FindComponentByClass<USplineMeshComponent>() || Actor->FindComponentByClass<UPowerlineStreamingComponent>());
+	}
+
+	/** Transform ResolvePoleActors reads PoleRef's sockets with, false when the pole is gone. */
+	static bool GetPoleTransform(const FPowerlinePoleRef& PoleRef, FTransform& OutTransform)
+	{
+		if (const UInstancedStaticMeshComponent* Instances = PoleRef.Instances.Get())
+		{
+			return Instances->GetInstanceTransform(PoleRef.InstanceIndex, OutTransform, true);
+		}
+
+		const AActor* Actor = PoleRef.Actor.Get();
+		if (!Actor) return false;
+
+		const UStaticMeshComponent* MeshComponent = Actor->GetComponentByClass<UStaticMeshComponent>();
+		OutTransform = MeshComponent ? MeshComponent->GetComponentTransform() : Actor->GetActorTransform();
+		return true;
+	}
+
+	/** Same order as UStaticMeshComponent::GetAllSocketNames so actors, instances and transforms pair up identically. */
+	static void AddSocketLocations(const FTransform& PoleTransform, TConstArrayView<TObjectPtr<UStaticMeshSocket>> Sockets, FPowerlineScratchLocations& OutSocketLocations)
+	{
+		if (Sockets.IsEmpty())
+		{
+			OutSocketLocations.Add(PoleTransform.GetLocation());
+			return;
+		}
+
+		for (const UStaticMeshSocket* Socket : Sockets)
+		{
+			OutSocketLocations.Add(PoleTransform.TransformPosition(Socket ? Socket->RelativeLocation : FVector::ZeroVector));
+		}
+	}
+}
+
+void UPowerlineGenerationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LevelActorDeletedHandle = GEngine->OnLevelActorDeleted().AddUObject(this, &UPowerlineGenerationSubsystem::OnLevelActorDeleted);
+	LevelActorAddedHandle = GEngine->OnLevelActorAdded().AddUObject(this, &UPowerlineGenerationSubsystem::OnLevelActorAdded);
+
+	// Actors that show up without an added event are found by scanning the world again on the next lookup
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddWeakLambda(this, [this](ULevel*, UWorld*) { bCableMeshIndexDirty = bCostReportDirty = true; });
+	LoaderAdapterHandle = UWorldPartition::LoaderAdapterStateChanged.AddWeakLambda(this, [this](const IWorldPartitionActorLoaderInterface::ILoaderAdapter*) { bCableMeshIndexDirty = bCostReportDirty = true; });
+	UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddWeakLambda(this, [this]() { bCableMeshIndexDirty = bCostReportDirty = true; });
+}
+
+void UPowerlineGenerationSubsystem::Deinitialize()
+{
+	if (GEngine)
+	{
+		GEngine->OnLevelActorDeleted().Remove(LevelActorDeletedHandle);
+		GEngine->OnLevelActorAdded().Remove(LevelActorAddedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	UWorldPartition::LoaderAdapterStateChanged.Remove(LoaderAdapterHandle);
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+
+	Super::Deinitialize();
+}
+
+FPowerlineGenerationResult UPowerlineGenerationSubsystem::GenerateForActors(const TArray<AActor*>& Poles, const FPowerlineGenerationSettings& Settings)
+{
+	FPowerlineGenerationResult Result;
+	FMemMark Mark(FMemStack::Get());
+
+	const double StartTime = FPlatformTime::Seconds();
+	FPowerlineScratchLocations PoleLocations;
+	FPowerlineScratchLocations SocketLocations;
+	FPowerlineScratchPoleRefs PoleRefs;
+	int32 NumSocketsPerPole = 0;
+	const bool bResolved = ResolvePoleActors(Poles, Settings, PoleLocations, SocketLocations, NumSocketsPerPole, &PoleRefs);
+	Result.ResolveSeconds = FPlatformTime::Seconds() - StartTime;
+	if (!bResolved) return Result;
+
+	UWorld* World = nullptr;
+	for (AActor* Pole : Poles)
+	{
+		if (Pole)
+		{
+			World = Pole->GetWorld();
+			break;
+		}
+	}
+
+	GeneratePowerlines(World, PoleLocations, SocketLocations, NumSocketsPerPole, Settings, Result, PoleRefs);
+	return Result;
+}
+
+FPowerlineGenerationResult UPowerlineGenerationSubsystem::GenerateForTransforms(const TArray<FTransform>& PoleTransforms, UStaticMesh* PoleMesh, const FPowerlineGenerationSettings& Settings)
+{
+	FPowerlineGenerationResult Result;
+	FMemMark Mark(FMemStack::Get());
+
+	const double StartTime = FPlatformTime::Seconds();
+	FPowerlineScratchLocations PoleLocations;
+	FPowerlineScratchLocations SocketLocations;
+	int32 NumSocketsPerPole = 0;
+	ResolvePoleTransforms(PoleTransforms, PoleMesh, Settings, PoleLocations, SocketLocations, NumSocketsPerPole);
+	Result.ResolveSeconds = FPlatformTime::Seconds() - StartTime;
+
+	GeneratePowerlines(GEditor->GetEditorWorldContext().World(), PoleLocations, SocketLocations, NumSocketsPerPole, Settings, Result);
+	return Result;
+}
+
+FPowerlineGenerationResult UPowerlineGenerationSubsystem::GenerateForInstances(UInstancedStaticMeshComponent* PoleInstances, const TArray<int32>& InstanceIndices, const FPowerlineGenerationSettings& Settings)
+{
+	FPowerlineGenerationResult Result;
+	if (!PoleInstances || !PoleInstances->GetStaticMesh()) return Result;
+
+	FMemMark Mark(FMemStack::Get());
+	const double StartTime = FPlatformTime::Seconds();
+	FPowerlineScratchLocations PoleLocations;
+	FPowerlineScratchLocations SocketLocations;
+	FPowerlineScratchPoleRefs PoleRefs;
+	int32 NumSocketsPerPole = 0;
+	ResolvePoleInstances(PoleInstances, InstanceIndices, Settings, PoleLocations, SocketLocations, NumSocketsPerPole, &PoleRefs);
+	Result.ResolveSeconds = FPlatformTime::Seconds() - StartTime;
+
+	GeneratePowerlines(PoleInstances->GetWorld(), PoleLocations, SocketLocations, NumSocketsPerPole, Settings, Result, PoleRefs);
+	return Result;
+}
+
+FPowerlineGenerationResult UPowerlineGenerationSubsystem::GenerateAlongSpline(USplineComponent* GuideSpline, const FPowerlinePolePlacementSettings& Placement, const FPowerlineGenerationSettings& Settings)
+{
+	FPowerlineGenerationResult Result;
+	UWorld* World = GuideSpline ? GuideSpline->GetWorld() : nullptr;
+	if (!World || !Placement.PoleMesh)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Pole placement needs a guide spline in a level and a pole mesh"));
+		return Result;
+	}
+
+	const double PlacementStartTime = FPlatformTime::Seconds();
+	TArray<FTransform> PoleTransforms;
+	PlacePolesAlongSpline(GuideSpline, Placement, PoleTransforms);
+
+	UHierarchicalInstancedStaticMeshComponent* PoleInstances = SpawnPoleInstances(World, PoleTransforms, Placement.PoleMesh);
+	if (!PoleInstances) return Result;
+
+	AActor* PoleActor = PoleInstances->GetOwner();
+	Result.CreatedActors.Add(PoleActor);
+	Result.NumPlacedPoles = PoleTransforms.Num();
+	Result.PlacementSeconds = FPlatformTime::Seconds() - PlacementStartTime;
+
+	FMemMark Mark(FMemStack::Get());
+	const double ResolveStartTime = FPlatformTime::Seconds();
+	FPowerlineScratchLocations PoleLocations;
+	FPowerlineScratchLocations SocketLocations;
+	int32 NumSocketsPerPole = 0;
+	ResolvePoleTransforms(PoleTransforms, Placement.PoleMesh, Settings, PoleLocations, SocketLocations, NumSocketsPerPole);
+	FPowerlineScratchPoleRefs PoleRefs;
+	PoleRefs.Reserve(PoleTransforms.Num());
+	for (int32 Pole = 0; Pole < PoleTransforms.Num(); Pole++)
+	{
+		PoleRefs.Emplace(PoleActor, PoleInstances, Pole);
+	}
+	Result.ResolveSeconds = FPlatformTime::Seconds() - ResolveStartTime;
+
+	GeneratePowerlines(World, PoleLocations, SocketLocations, NumSocketsPerPole, Settings, Result, PoleRefs);
+
+	// Poles without cables, e.g. when the budget refused them, would be left behind as an orphan actor
+	if (!Result.bSuccess)
+	{
+		Result.CreatedActors.Remove(PoleActor);
+		Result.NumPlacedPoles = 0;
+		World->DestroyActor(PoleActor);
+	}
+	return Result;
+}
+
+FPowerlineGenerationResult UPowerlineGenerationSubsystem::GenerateForSelection(const FPowerlineGenerationSettings& Settings)
+{
+	TArray<AActor*> ActorSelection;
+	GEditor->GetSelectedActors()->GetSelectedObjects<AActor>(ActorSelection);
+	if (ActorSelection.Num() < 2)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Select atleast 2 actors"));
+		return FPowerlineGenerationResult();
+	}
+
+	return GenerateForActors(ActorSelection, Settings);
+}
+
+FPowerlineGenerationPlan UPowerlineGenerationSubsystem::PlanForActors(const TArray<AActor*>& Poles, const FPowerlineGenerationSettings& Settings)
+{
+	FPowerlineGenerationPlan Plan;
+	Plan.Settings = Settings;
+	const double StartTime = FPlatformTime::Seconds();
+	{
+		FMemMark Mark(FMemStack::Get());
+		FPowerlineScratchLocations PoleLocations;
+		FPowerlineScratchLocations SocketLocations;
+		FPowerlineScratchPoleRefs PoleRefs;
+		if (!ResolvePoleActors(Poles, Settings, PoleLocations, SocketLocations, Plan.NumSocketsPerPole, &PoleRefs))
+		{
+			Plan.Error = TEXT("Every pole needs a mesh with the same number of sockets");
+			Plan.PlanSeconds = FPlatformTime::Seconds() - StartTime;
+			return Plan;
+		}
+		Plan.PoleLocations = PoleLocations;
+		Plan.SocketLocations = SocketLocations;
+		Plan.PoleRefs = PoleRefs;
+	}
+
+	Plan.PoleTransforms.SetNum(Plan.PoleRefs.Num());
+	for (int32 Pole = 0; Pole < Plan.PoleRefs.Num(); Pole++)
+	{
+		PowerlineGenerationSubsystem::GetPoleTransform(Plan.PoleRefs[Pole], Plan.PoleTransforms[Pole]);
+	}
+
+	for (AActor* Pole : Poles)
+	{
+		if (Pole)
+		{
+			Plan.World = Pole->GetWorld();
+			break;
+		}
+	}
+
+	EstimatePlan(Plan);
+	Plan.PlanSeconds = FPlatformTime::Seconds() - StartTime;
+	return Plan;
+}
+
+FPowerlineGenerationPlan UPowerlineGenerationSubsystem::PlanForSelection(const FPowerlineGenerationSettings& Settings)
+{
+	TArray<AActor*> ActorSelection;
+	GEditor->GetSelectedActors()->GetSelectedObjects<AActor>(ActorSelection);
+	return PlanForActors(ActorSelection, Settings);
+}
+
+FPowerlineGenerationResult UPowerlineGenerationSubsystem::CommitPlan(const FPowerlineGenerationPlan& Plan)
+{
+	FPowerlineGenerationResult Result;
+	if (!Plan.bValid || Plan.bRefusedByBudget)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Powerline plan not committed: %s"), Plan.bValid ? TEXT("refused by the cable budget") : *Plan.Error);
+		return Result;
+	}
+
+	UWorld* World = Plan.World.Get();
+	const bool bPolesDeleted = Plan.PoleRefs.ContainsByPredicate([](const FPowerlinePoleRef& PoleRef) { return PoleRef.Actor.IsStale() || PoleRef.Instances.IsStale(); });
+	if (!World || bPolesDeleted)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Powerline plan not committed: its level or poles are gone, plan again"));
+		return Result;
+	}
+
+	// Socket locations were resolved from where the poles stood when planning, a new plan shows what moving them changed
+	if (!IsPlanCurrent(Plan))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Powerline plan not committed: poles moved, plan again"));
+		return Result;
+	}
+
+	ExecuteGeneration(World, Plan.PoleLocations, Plan.SocketLocations, Plan.NumSocketsPerPole, Plan.Settings, Result, Plan.PoleRefs);
+	return Result;
+}
+
+bool UPowerlineGenerationSubsystem::IsPlanCurrent(const FPowerlineGenerationPlan& Plan) const
+{
+	if (!Plan.World.IsValid() || Plan.PoleTransforms.Num() != Plan.PoleRefs.Num()) return false;
+
+	for (int32 Pole = 0; Pole < Plan.PoleRefs.Num(); Pole++)
+	{
+		FTransform PoleTransform;
+		if (!PowerlineGenerationSubsystem::GetPoleTransform(Plan.PoleRefs[Pole], PoleTransform) || !PoleTransform.Equals(Plan.PoleTransforms[Pole])) return false;
+	}
+	return true;
+}
+
+int32 UPowerlineGenerationSubsystem::RegenerateSelection()
+{
+	TArray<AActor*> ActorSelection;
+	GEditor->GetSelectedActors()->GetSelectedObjects<AActor>(ActorSelection);
+	if (ActorSelection.IsEmpty()) return 0;
+
+	if (const UPowerlineNetworkGraph* Graph = GetNetworkGraph(ActorSelection[0]->GetWorld()))
+	{
+		for (AActor* CableActor : Graph->GetCableActorsOfPoles(ActorSelection))
+		{
+			ActorSelection.AddUnique(CableActor);
+		}
+	}
+	return RegenerateCables(ActorSelection);
+}
+
+int32 UPowerlineGenerationSubsystem::RegenerateCables(const TArray<AActor*>& CableActors)
+{
+	int32 NumUpdated = 0;
+	for (AActor* Object : CableActors)
+	{
+		if (!Object) continue;
+
+		TArray<TPair<USplineComponent*, PowerlineGenerationSubsystem::FSplineSegments>> Splines;
+		PowerlineGenerationSubsystem::GetSplineSegments(Object, Splines);
+		for (const TPair<USplineComponent*, PowerlineGenerationSubsystem::FSplineSegments>& Spline : Splines)
+		{
+			const int32 NumSegments = FMath::Min(Spline.Value.Num(), Spline.Key->GetNumberOfSplinePoints() - 1);
+			for (int32 Segment = 0; Segment < NumSegments; Segment++)
+			{
+				FVector StartLocation, StartTangent, EndLocation, EndTangent;
+				Spline.Key->GetLocationAndTangentAtSplinePoint(Segment, StartLocation, StartTangent, ESplineCoordinateSpace::Local);
+				Spline.Key->GetLocationAndTangentAtSplinePoint(Segment + 1, EndLocation, EndTangent, ESplineCoordinateSpace::Local);
+
+				Spline.Value[Segment]->SetStartAndEnd(StartLocation, StartTangent, EndLocation, EndTangent);
+				NumUpdated++;
+			}
+		}
+
+		if (UPowerlineCableCollisionComponent* CollisionComp = Object->GetComponentByClass<UPowerlineCableCollisionComponent>())
+		{
+			TInlineComponentArray<USplineMeshComponent*> SplineMeshes(Object);
+			CollisionComp->BuildFromSplineMeshes(SplineMeshes);
+		}
+	}
+	return NumUpdated;
+}
+
+int32 UPowerlineGenerationSubsystem::ApplyParametersToSelection(const FPowerlineGenerationSettings& Settings)
+{
+	TArray<AActor*> ActorSelection;
+	GEditor->GetSelectedActors()->GetSelectedObjects<AActor>(ActorSelection);
+	return ApplyParameters(ActorSelection, Settings);
+}
+
+int32 UPowerlineGenerationSubsystem::ApplyParameters(const TArray<AActor*>& CableActors, const FPowerlineGenerationSettings& Settings)
+{
+	using namespace PowerlineGenerationSubsystem;
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 NumSegments = FMath::Max(1, Settings.SplineSegments);
+	UPowerlineNetworkGraph* Graph = nullptr;
+	int32 NumUpdated = 0;
+
+	// Existing cables are rewritten in place, everything touched is recorded so one undo restores them
+	const FScopedTransaction Transaction(NSLOCTEXT("PowerlineTool", "ApplyParameters", "Apply Powerline Settings"));
+
+	// Gather the span ends of every cable, sags come from the sag table which is only safe to build on this thread
+	TArray<FCableReshape> Reshapes;
+	TArray<AActor*, TInlineAllocator<64>> UpdatedActors;
+	TArray<TPair<USplineComponent*, FSplineSegments>> Splines;
+	for (AActor* CableActor : CableActors)
+	{
+		if (!CableActor) continue;
+
+		if (!Graph)
+		{
+			Graph = GetNetworkGraph(CableActor->GetWorld());
+			if (Graph)
+			{
+				Graph->Modify();
+			}
+		}
+		CableActor->Modify();
+		const TConstArrayView<int32> CableSpans = Graph ? Graph->FindCableSpans(CableActor) : TConstArrayView<int32>();
+
+		if (UPowerlineStreamingComponent* StreamingComp = CableActor->FindComponentByClass<UPowerlineStreamingComponent>())
+		{
+			StreamingComp->Modify();
+			const FTransform& ComponentTransform = StreamingComp->GetComponentTransform();
+			for (int32 Span = 0; Span < StreamingComp->GetSpans().Num(); Span++)
+			{
+				const FPowerlineSpanDescriptor& Descriptor = StreamingComp->GetSpans()[Span];
+				const FVector SpanStart = ComponentTransform.TransformPosition(FVector(Descriptor.Start));
+				const FVector SpanEnd = ComponentTransform.TransformPosition(FVector(Descriptor.End));
+				StreamingComp->SetSpanShape(Span, GetSpanSag(SpanStart, SpanEnd, Settings), NumSegments);
+			}
+			NumUpdated += StreamingComp->GetSpans().Num();
+			CableActor->MarkPackageDirty();
+			continue;
+		}
+
+		if (UPowerlineCompactCableComponent* CompactComp = CableActor->FindComponentByClass<UPowerlineCompactCableComponent>())
+		{
+			CompactComp->Modify();
+			const FTransform& ComponentTransform = CompactComp->GetComponentTransform();
+			for (int32 Cable = 0; Cable < CompactComp->GetCables().Num(); Cable++)
+			{
+				FCableReshape& Reshape = Reshapes.AddDefaulted_GetRef();
+				Reshape.CableActor = CableActor;
+				Reshape.Compact = CompactComp;
+				Reshape.CompactCable = Cable;
+				Reshape.ComponentTransform = ComponentTransform;
+				Reshape.SpanEnds.Add(ComponentTransform.TransformPosition(FVector(CompactComp->GetCables()[Cable].Start)));
+				Reshape.SpanEnds.Add(ComponentTransform.TransformPosition(FVector(CompactComp->GetCables()[Cable].End)));
+
+				// Compact cables were recorded in cable order
+				if (CableSpans.IsValidIndex(Cable))
+				{
+					Reshape.GraphSpans.Add(CableSpans[Cable]);
+				}
+			}
+			UpdatedActors.Add(CableActor);
+			continue;
+		}
+
+		GetSplineSegments(CableActor, Splines);
+		for (TPair<USplineComponent*, FSplineSegments>& Spline : Splines)
+		{
+			USplineComponent* SplineComp = Spline.Key;
+			const int32 NumPoints = SplineComp->GetNumberOfSplinePoints();
+			if (NumPoints < 2) continue;
+
+			FCableReshape Reshape;
+			Reshape.CableActor = CableActor;
+			Reshape.Spline = SplineComp;
+			Reshape.ComponentTransform = SplineComp->GetComponentTransform();
+			const FSoftObjectPath SplinePath(SplineComp);
+			for (int32 Span : CableSpans)
+			{
+				const TConstArrayView<TSoftObjectPtr<UActorComponent>> SpanComponents = Graph->GetSpanComponents(Span);
+				if (!SpanComponents.IsEmpty() && SpanComponents[0].ToSoftObjectPath() == SplinePath)
+				{
+					Reshape.GraphSpans.Add(Span);
+				}
+			}
+
+			if (!SplineComp->ComponentHasTag(ContinuousCableTag))
+			{
+				Reshape.SpanEnds.Add(SplineComp->GetLocationAtSplinePoint(0, ESplineCoordinateSpace::World));
+				Reshape.SpanEnds.Add(SplineComp->GetLocationAtSplinePoint(NumPoints - 1, ESplineCoordinateSpace::World));
+			}
+			else
+			{
+				// Span boundaries of a continuous cable are where the segments of its graph spans meet
+				for (int32 Span : Reshape.GraphSpans)
+				{
+					const TConstArrayView<TSoftObjectPtr<UActorComponent>> SpanComponents = Graph->GetSpanComponents(Span);
+					const USplineMeshComponent* FirstSegment = SpanComponents.Num() > 1 ? Cast<USplineMeshComponent>(SpanComponents[1].Get()) : nullptr;
+					const USplineMeshComponent* LastSegment = SpanComponents.Num() > 1 ? Cast<USplineMeshComponent>(SpanComponents.Last().Get()) : nullptr;
+					if (!FirstSegment || !LastSegment)
+					{
+						Reshape.SpanEnds.Reset();
+						break;
+					}
+					if (Reshape.SpanEnds.IsEmpty())
+					{
+						Reshape.SpanEnds.Add(FirstSegment->GetComponentTransform().TransformPosition(FirstSegment->GetStartPosition()));
+					}
+					Reshape.SpanEnds.Add(LastSegment->GetComponentTransform().TransformPosition(LastSegment->GetEndPosition()));
+				}
+				if (Reshape.SpanEnds.IsEmpty())
+				{
+					UE_LOG(LogTemp, Warning, TEXT("Skipping continuous cable %s, its spans are not in the network graph"), *SplineComp->GetReadableName());
+					continue;
+				}
+			}
+
+			SplineComp->Modify();
+			for (USplineMeshComponent* Segment : Spline.Value)
+			{
+				Segment->Modify();
+			}
+			Reshape.Segments = MoveTemp(Spline.Value);
+			Reshapes.Add(MoveTemp(Reshape));
+		}
+		UpdatedActors.Add(CableActor);
+	}
+
+	for (FCableReshape& Reshape : Reshapes)
+	{
+		for (int32 Span = 0; Span < Reshape.SpanEnds.Num() - 1; Span++)
+		{
+			Reshape.Sags.Add(GetSpanSag(Reshape.SpanEnds[Span], Reshape.SpanEnds[Span + 1], Settings));
+		}
+	}
+
+	// The cable math of every cable is independent, only the component updates below need the game thread
+	ParallelFor(Reshapes.Num(), [&Reshapes, NumSegments](int32 Index)
+		{
+			FCableReshape& Reshape = Reshapes[Index];
+			const int32 NumSpans = Reshape.Sags.Num();
+			Reshape.Points.SetNumUninitialized(NumSpans * NumSegments + 1);
+			Reshape.Tangents.SetNumUninitialized(NumSpans * NumSegments + 1);
+			for (int32 Span = 0; Span < NumSpans; Span++)
+			{
+				FPowerlineCableMath::ComputeSpanPoints(Reshape.SpanEnds[Span], Reshape.SpanEnds[Span + 1], Reshape.Sags[Span], NumSegments, MakeArrayView(Reshape.Points).Mid(Span * NumSegments, NumSegments + 1));
+			}
+			for (FVector& Point : Reshape.Points)
+			{
+				Point = Reshape.ComponentTransform.InverseTransformPosition(Point);
+			}
+			FPowerlineCableMath::ComputeTangents(Reshape.Points, Reshape.Tangents);
+		});
+
+	TArray<UPowerlineCompactCableComponent*, TInlineAllocator<64>> UpdatedCompacts;
+	for (FCableReshape& Reshape : Reshapes)
+	{
+		NumUpdated++;
+		if (Reshape.Compact)
+		{
+			Reshape.Compact->SetCablePoints(Reshape.CompactCable, Reshape.Points);
+			UpdatedCompacts.AddUnique(Reshape.Compact);
+			continue;
+		}
+
+		SetLocalSplinePoints(Reshape.Spline, Reshape.Points);
+		ReshapeSplineSegments(Reshape.CableActor, Reshape.Spline, Reshape.Segments, Reshape.Points, Reshape.Tangents);
+
+		if (Graph)
+		{
+			TArray<UActorComponent*, TInlineAllocator<16>> SpanComponents;
+			for (int32 Span = 0; Span < Reshape.GraphSpans.Num(); Span++)
+			{
+				SpanComponents.Reset();
+				SpanComponents.Add(Reshape.Spline);
+				SpanComponents.Append(MakeArrayView(Reshape.Segments).Mid(Span * NumSegments, NumSegments));
+				Graph->SetSpanComponents(Reshape.GraphSpans[Span], SpanComponents);
+			}
+		}
+	}
+
+	for (UPowerlineCompactCableComponent* CompactComp : UpdatedCompacts)
+	{
+		CompactComp->RebuildSegments();
+	}
+	if (Graph)
+	{
+		for (const FCableReshape& Reshape : Reshapes)
+		{
+			if (!Reshape.Compact || !Reshape.GraphSpans.IsValidIndex(0)) continue;
+
+			const TConstArrayView<TObjectPtr<USplineMeshComponent>> CableSegments = Reshape.Compact->GetSegments().Mid(Reshape.CompactCable * NumSegments, NumSegments);
+			TArray<UActorComponent*, TInlineAllocator<16>> SpanComponents;
+			SpanComponents.Add(Reshape.Compact);
+			for (USplineMeshComponent* Segment : CableSegments)
+			{
+				SpanComponents.Add(Segment);
+			}
+			Graph->SetSpanComponents(Reshape.GraphSpans[0], SpanComponents);
+		}
+		Graph->MarkPackageDirty();
+	}
+
+	for (AActor* CableActor : UpdatedActors)
+	{
+		if (UPowerlineCableCollisionComponent* CollisionComp = CableActor->GetComponentByClass<UPowerlineCableCollisionComponent>())
+		{
+			TInlineComponentArray<USplineMeshComponent*> SplineMeshes(CableActor);
+			CollisionComp->Modify();
+			CollisionComp->BuildFromSplineMeshes(SplineMeshes);
+		}
+		if (UPowerlineWindComponent* WindComp = CableActor->GetComponentByClass<UPowerlineWindComponent>(); WindComp && WindComp->SegmentsPerCable > 0)
+		{
+			WindComp->Modify();
+			WindComp->SegmentsPerCable = NumSegments;
+		}
+		IndexCableActor(CableActor);
+		CableActor->MarkPackageDirty();
+	}
+
+	// Segment counts changed in place, the cost report is gathered again
+	bCostReportDirty = true;
+	UE_LOG(LogTemp, Log, TEXT("Applied %d segments and new sag to %d cables in %d actors in %.3fs"), NumSegments, NumUpdated, CableActors.Num(), FPlatformTime::Seconds() - StartTime);
+	return NumUpdated;
+}
+
+void UPowerlineGenerationSubsystem::FindCableMeshUsers(UWorld* World, const UStaticMesh* CableMesh, TArray<UActorComponent*>& OutComponents)
+{
+	OutComponents.Reset();
+	if (!World || !CableMesh) return;
+
+	UpdateCableMeshIndex(World);
+	TSet<TWeakObjectPtr<UActorComponent>>* Users = CableMeshUsers.Find(CableMesh);
+	if (!Users) return;
+
+	// Entries go stale when a component is deleted or gets another mesh outside the tool, they are moved or dropped here
+	TArray<UActorComponent*, TInlineAllocator<16>> MovedComponents;
+	for (auto It = Users->CreateIterator(); It; ++It)
+	{
+		UActorComponent* Component = It->Get();
+		if (!IsValid(Component) || Component->GetWorld() != World)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (PowerlineGenerationSubsystem::GetIndexedCableMesh(Component) != CableMesh)
+		{
+			MovedComponents.Add(Component);
+			It.RemoveCurrent();
+			continue;
+		}
+		OutComponents.Add(Component);
+	}
+	for (UActorComponent* Component : MovedComponents)
+	{
+		IndexCableComponent(Component);
+	}
+}
+
+int32 UPowerlineGenerationSubsystem::RetargetCableMesh(UWorld* World, UStaticMesh* OldMesh, UStaticMesh* NewMesh, FVector2D Scale)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<UActorComponent*> Components;
+	FindCableMeshUsers(World, OldMesh, Components);
+	if (Components.IsEmpty()) return 0;
+
+	UStaticMesh* TargetMesh = NewMesh ? NewMesh : OldMesh;
+	const bool bKeepScale = Scale.IsNearlyZero();
+	const FScopedTransaction Transaction(NSLOCTEXT("PowerlineTool", "RetargetCableMesh", "Swap Cable Mesh In Level"));
+
+	// Components are updated in place, collision follows once per actor after all of its segments changed
+	TSet<AActor*> UpdatedActors;
+	for (UActorComponent* Component : Components)
+	{
+		Component->Modify();
+		if (USplineMeshComponent* Segment = Cast<USplineMeshComponent>(Component))
+		{
+			PowerlineRuntime::SetSegmentMesh(Segment, TargetMesh, bKeepScale ? Segment->GetStartScale() : Scale);
+		}
+		else if (UPowerlineCompactCableComponent* CompactComp = Cast<UPowerlineCompactCableComponent>(Component))
+		{
+			CompactComp->SetCableMesh(TargetMesh, bKeepScale ? CompactComp->CableScale : Scale);
+		}
+		else if (UPowerlineStreamingComponent* StreamingComp = Cast<UPowerlineStreamingComponent>(Component))
+		{
+			StreamingComp->SetCableMesh(TargetMesh, bKeepScale ? StreamingComp->CableScale : Scale);
+		}
+		UpdatedActors.Add(Component->GetOwner());
+	}
+
+	TSet<TWeakObjectPtr<UActorComponent>> MovedUsers = MoveTemp(CableMeshUsers.FindChecked(OldMesh));
+	CableMeshUsers.Remove(OldMesh);
+	CableMeshUsers.FindOrAdd(TargetMesh).Append(MoveTemp(MovedUsers));
+
+	for (AActor* CableActor : UpdatedActors)
+	{
+		if (UPowerlineCableCollisionComponent* CollisionComp = CableActor->GetComponentByClass<UPowerlineCableCollisionComponent>())
+		{
+			TInlineComponentArray<USplineMeshComponent*> SplineMeshes(CableActor);
+			CollisionComp->Modify();
+			CollisionComp->BuildFromSplineMeshes(SplineMeshes);
+		}
+		CableActor->MarkPackageDirty();
+	}
+
+	bCostReportDirty = true;
+	UE_LOG(LogTemp, Log, TEXT("Retargeted %d cable components in %d actors from %s to %s in %.3fs"),
+		Components.Num(), UpdatedActors.Num(), *OldMesh->GetName(), *TargetMesh->GetName(), FPlatformTime::Seconds() - StartTime);
+	return Components.Num();
+}
+
+void UPowerlineGenerationSubsystem::UpdateCableMeshIndex(UWorld* World)
+{
+	if (!bCableMeshIndexDirty && CableMeshIndexWorld.Get() == World) return;
+
+	CableMeshUsers.Reset();
+	CableMeshIndexWorld = World;
+	bCableMeshIndexDirty = false;
+	for (ULevel* Level : World->GetLevels())
+	{
+		for (AActor* Actor : Level->Actors)
+		{
+			IndexCableActor(Actor);
+		}
+	}
+}
+
+void UPowerlineGenerationSubsystem::IndexCableActor(AActor* Actor)
+{
+	// An index that is rebuilt on the next lookup anyway is not kept up to date
+	if (!Actor || bCableMeshIndexDirty || Actor->GetWorld() != CableMeshIndexWorld.Get()) return;
+
+	if (UPowerlineStreamingComponent* StreamingComp = Actor->FindComponentByClass<UPowerlineStreamingComponent>())
+	{
+		IndexCableComponent(StreamingComp);
+	}
+	if (UPowerlineCompactCableComponent* CompactComp = Actor->FindComponentByClass<UPowerlineCompactCableComponent>())
+	{
+		IndexCableComponent(CompactComp);
+	}
+
+	// Only the segments of generated splines, the transient ones of compact and streaming components belong to those
+	TArray<TPair<USplineComponent*, PowerlineGenerationSubsystem::FSplineSegments>> Splines;
+	PowerlineGenerationSubsystem::GetSplineSegments(Actor, Splines);
+	for (const TPair<USplineComponent*, PowerlineGenerationSubsystem::FSplineSegments>& Spline : Splines)
+	{
+		for (USplineMeshComponent* Segment : Spline.Value)
+		{
+			IndexCableComponent(Segment);
+		}
+	}
+}
+
+void UPowerlineGenerationSubsystem::IndexCableComponent(UActorComponent* Component)
+{
+	if (UStaticMesh* CableMesh = PowerlineGenerationSubsystem::GetIndexedCableMesh(Component))
+	{
+		CableMeshUsers.FindOrAdd(CableMesh).Add(Component);
+	}
+}
+
+void UPowerlineGenerationSubsystem::ReshapeSplineSegments(AActor* CableActor, USplineComponent* SplineComp, TArray<USplineMeshComponent*, TInlineAllocator<16>>& Segments, TConstArrayView<FVector> Points, TConstArrayView<FVector> Tangents) const
+{
+	// Existing segments are reused in order, only the difference in segment count is created or destroyed
+	const int32 NumSegments = Points.Num() - 1;
+	const USplineMeshComponent* Template = Segments.IsEmpty() ? nullptr : Segments[0];
+	while (Segments.Num() > NumSegments)
+	{
+		USplineMeshComponent* Segment = Segments.Pop();
+		CableActor->RemoveInstanceComponent(Segment);
+		Segment->DestroyComponent();
+	}
+	while (Segments.Num() < NumSegments)
+	{
+		UStaticMesh* CableMesh = Template ? Template->GetStaticMesh() : nullptr;
+		const FName CollisionProfile = Template ? Template->GetCollisionProfileName() : UCollisionProfile::NoCollision_ProfileName;
+		USplineMeshComponent* Segment = CreateSplineMeshComponent(SplineComp, CableActor, CableMesh, CollisionProfile);
+		if (!Segment) break;
+
+		// Keeps a scale set by RetargetCableMesh
+		if (Template)
+		{
+			Segment->SetStartScale(Template->GetStartScale(), false);
+			Segment->SetEndScale(Template->GetEndScale(), false);
+		}
+		Segments.Add(Segment);
+	}
+
+	for (int32 Segment = 0; Segment < Segments.Num(); Segment++)
+	{
+		Segments[Segment]->SetStartAndEnd(Points[Segment], Tangents[Segment], Points[Segment + 1], Tangents[Segment + 1]);
+	}
+}
+
+bool UPowerlineGenerationSubsystem::ResolvePoleActors(TArrayView<AActor* const> Poles, const FPowerlineGenerationSettings& Settings, FPowerlineScratchLocations& OutPoleLocations, FPowerlineScratchLocations& OutSocketLocations, int32& OutNumSocketsPerPole, FPowerlineScratchPoleRefs* OutPoleRefs) const
+{
+	OutPoleLocations.Reset();
+	OutSocketLocations.Reset();
+	OutNumSocketsPerPole = 0;
+	if (OutPoleRefs)
+	{
+		OutPoleRefs->Reset(Poles.Num());
+	}
+	auto AddPoleRef = [OutPoleRefs](AActor* Actor, UInstancedStaticMeshComponent* Instances, int32 InstanceIndex)
+		{
+			if (OutPoleRefs)
+			{
+				OutPoleRefs->Emplace(Actor, Instances, InstanceIndex);
+			}
+		};
+
+	for (AActor* Actor : Poles)
+	{
+		if (!Actor) continue;
+
+		if (!Settings.bAttachToSockets)
+		{
+			if (OutNumSocketsPerPole == 0)
+			{
+				OutNumSocketsPerPole = 1;
+				OutPoleLocations.Reserve(Poles.Num());
+				OutSocketLocations.Reserve(Poles.Num());
+			}
+			if (UInstancedStaticMeshComponent* PoleInstances = Actor->GetComponentByClass<UInstancedStaticMeshComponent>())
+			{
+				for (int32 Instance = 0; Instance < PoleInstances->GetInstanceCount(); Instance++)
+				{
+					FTransform InstanceTransform;
+					PoleInstances->GetInstanceTransform(Instance, InstanceTransform, true);
+					OutPoleLocations.Add(InstanceTransform.GetLocation());
+					OutSocketLocations.Add(InstanceTransform.GetLocation());
+					AddPoleRef(Actor, PoleInstances, Instance);
+				}
+				continue;
+			}
+			OutPoleLocations.Add(Actor->GetActorLocation());
+			OutSocketLocations.Add(Actor->GetActorLocation());
+			AddPoleRef(Actor, nullptr, INDEX_NONE);
+			continue;
+		}
+
+		UStaticMeshComponent* MeshComponent = Actor->GetComponentByClass<UStaticMeshComponent>();
+		if (!MeshComponent)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("One of selected actors, don't have MeshComponent"));
+			OutPoleLocations.Reset();
+			OutSocketLocations.Reset();
+			return false;
+		}
+
+		// Read the mesh sockets in place, GetAllSocketNames would copy them into a new array per pole
+		const UStaticMesh* PoleMesh = MeshComponent->GetStaticMesh();
+		const int32 NumMeshSockets = PoleMesh ? PoleMesh->Sockets.Num() : 0;
+		const int32 NumSockets = FMath::Max(1, NumMeshSockets);
+		if (OutNumSocketsPerPole == 0)
+		{
+			OutNumSocketsPerPole = NumSockets;
+			OutPoleLocations.Reserve(Poles.Num());
+			OutSocketLocations.Reserve(Poles.Num() * NumSockets);
+		}
+		else if (OutNumSocketsPerPole != NumSockets)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("One of selected actors have different amount of sockets"));
+			OutPoleLocations.Reset();
+			OutSocketLocations.Reset();
+			return false;
+		}
+
+		// Instanced poles are one pole per instance, in instance order, e.g. a whole line placed along a guide spline
+		if (UInstancedStaticMeshComponent* PoleInstances = Cast<UInstancedStaticMeshComponent>(MeshComponent))
+		{
+			const int32 NumInstances = PoleInstances->GetInstanceCount();
+			OutPoleLocations.Reserve(OutPoleLocations.Num() + NumInstances);
+			OutSocketLocations.Reserve(OutSocketLocations.Num() + NumInstances * NumSockets);
+			const TArray<TObjectPtr<UStaticMeshSocket>> NoSockets;
+			for (int32 Instance = 0; Instance < NumInstances; Instance++)
+			{
+				FTransform InstanceTransform;
+				PoleInstances->GetInstanceTransform(Instance, InstanceTransform, true);
+				OutPoleLocations.Add(InstanceTransform.GetLocation());
+				PowerlineGenerationSubsystem::AddSocketLocations(InstanceTransform, NumMeshSockets > 0 ? PoleMesh->Sockets : NoSockets, OutSocketLocations);
+				AddPoleRef(Actor, PoleInstances, Instance);
+			}
+			continue;
+		}
+
+		OutPoleLocations.Add(Actor->GetActorLocation());
+		AddPoleRef(Actor, nullptr, INDEX_NONE);
+		if (NumMeshSockets == 0)
+		{
+			OutSocketLocations.Add(MeshComponent->GetComponentLocation());
+		}
+		else
+		{
+			for (const UStaticMeshSocket* Socket : PoleMesh->Sockets)
+			{
+				FTransform SocketTransform;
+				const bool bValidSocket = Socket && Socket->GetSocketTransform(SocketTransform, MeshComponent);
+				OutSocketLocations.Add(bValidSocket ? SocketTransform.GetLocation() : MeshComponent->GetComponentLocation());
+			}
+		}
+	}
+	return true;
+}
+
+void UPowerlineGenerationSubsystem::ResolvePoleInstances(UInstancedStaticMeshComponent* PoleInstances, TArrayView<const int32> InstanceIndices, const FPowerlineGenerationSettings& Settings, FPowerlineScratchLocations& OutPoleLocations, FPowerlineScratchLocations& OutSocketLocations, int32& OutNumSocketsPerPole, FPowerlineScratchPoleRefs* OutPoleRefs) const
+{
+	if (OutPoleRefs)
+	{
+		OutPoleRefs->Reset(InstanceIndices.IsEmpty() ? PoleInstances->GetInstanceCount() : InstanceIndices.Num());
+	}
+
+	const int32 NumInstances = InstanceIndices.IsEmpty() ? PoleInstances->GetInstanceCount() : InstanceIndices.Num();
+	TArray<FTransform, TMemStackAllocator<>> InstanceTransforms;
+	InstanceTransforms.Reserve(NumInstances);
+	for (int32 Index = 0; Index < NumInstances; Index++)
+	{
+		const int32 Instance = InstanceIndices.IsEmpty() ? Index : InstanceIndices[Index];
+		FTransform InstanceTransform;
+		if (PoleInstances->GetInstanceTransform(Instance, InstanceTransform, true))
+		{
+			InstanceTransforms.Add(InstanceTransform);
+			if (OutPoleRefs)
+			{
+				OutPoleRefs->Emplace(PoleInstances->GetOwner(), PoleInstances, Instance);
+			}
+		}
+	}
+	ResolvePoleTransforms(InstanceTransforms, PoleInstances->GetStaticMesh(), Settings, OutPoleLocations, OutSocketLocations, OutNumSocketsPerPole);
+}
+
+void UPowerlineGenerationSubsystem::PlacePolesAlongSpline(const USplineComponent* GuideSpline, const FPowerlinePolePlacementSettings& Placement, TArray<FTransform>& OutPoleTransforms, FName IgnoredActorTag) const
+{
+	const float SplineLength = GuideSpline->GetSplineLength();
+	const int32 NumPoles = FMath::Max(2, FMath::RoundToInt(SplineLength / FMath::Max(Placement.TargetSpacing, 1.f)) + 1);
+	const float Spacing = SplineLength / (NumPoles - 1);
+
+	OutPoleTransforms.SetNum(NumPoles);
+	for (int32 Pole = 0; Pole < NumPoles; Pole++)
+	{
+		const float Distance = Spacing * Pole;
+		const FVector Location = GuideSpline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+		FRotator Rotation(0.f, Placement.YawOffset, 0.f);
+		if (Placement.bAlignToRoute)
+		{
+			Rotation.Yaw += GuideSpline->GetDirectionAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World).Rotation().Yaw;
+		}
+		OutPoleTransforms[Pole] = FTransform(Rotation, Location);
+	}
+
+	if (!Placement.bSnapToTerrain) return;
+
+	// Scene queries only take a read lock, so the traces of a long route run side by side in batches
+	const UWorld* World = GuideSpline->GetWorld();
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PowerlinePolePlacement), false);
+	const FVector TraceOffset(0.f, 0.f, Placement.TraceDistance);
+	const ECollisionChannel TraceChannel = Placement.TraceChannel;
+	ParallelFor(NumPoles, [World, &QueryParams, &TraceOffset, TraceChannel, IgnoredActorTag, &OutPoleTransforms](int32 Pole)
+		{
+			FTransform& PoleTransform = OutPoleTransforms[Pole];
+			const FVector Location = PoleTransform.GetLocation();
+			FCollisionQueryParams PoleQueryParams = QueryParams;
+			FHitResult Hit;
+			while (World->LineTraceSingleByChannel(Hit, Location + TraceOffset, Location - TraceOffset, TraceChannel, PoleQueryParams))
+			{
+				const AActor* HitActor = Hit.GetActor();
+				if (IgnoredActorTag.IsNone() || !HitActor || !HitActor->ActorHasTag(IgnoredActorTag))
+				{
+					PoleTransform.SetLocation(Hit.ImpactPoint);
+					break;
+				}
+				PoleQueryParams.AddIgnoredActor(HitActor);
+			}
+		}, EParallelForFlags::Unbalanced);
+}
+
+void UPowerlineGenerationSubsystem::ResolvePoleTransforms(TArrayView<const FTransform> Poles, const UStaticMesh* PoleMesh, const FPowerlineGenerationSettings& Settings, FPowerlineScratchLocations& OutPoleLocations, FPowerlineScratchLocations& OutSocketLocations, int32& OutNumSocketsPerPole) const
+{
+	const TArray<TObjectPtr<UStaticMeshSocket>> NoSockets;
+	const TArray<TObjectPtr<UStaticMeshSocket>>& Sockets = PoleMesh && Settings.bAttachToSockets ? PoleMesh->Sockets : NoSockets;
+
+	OutNumSocketsPerPole = FMath::Max(1, Sockets.Num());
+	OutPoleLocations.Reset(Poles.Num());
+	OutSocketLocations.Reset(Poles.Num() * OutNumSocketsPerPole);
+	for (const FTransform& PoleTransform : Poles)
+	{
+		OutPoleLocations.Add(PoleTransform.GetLocation());
+		PowerlineGenerationSubsystem::AddSocketLocations(PoleTransform, Sockets, OutSocketLocations);
+	}
+}
+
+void UPowerlineGenerationSubsystem::GeneratePowerlines(UWorld* World, TArrayView<const FVector> PoleLocations, TArrayView<const FVector> SocketLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, FPowerlineGenerationResult& OutResult, TArrayView<const FPowerlinePoleRef> PoleRefs)
+{
+	const int32 NumPoles = PoleLocations.Num();
+	if (!World || NumPoles < 2 || NumSocketsPerPole < 1 || SocketLocations.Num() != NumPoles * NumSocketsPerPole)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Powerline generation needs atleast 2 poles with matching socket locations"));
+		return;
+	}
+	// Settings built in script skip the ClampMin of the details panel
+	if (Settings.SplineSegments < 1)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Powerline generation needs atleast 1 spline segment per span, got %d"), Settings.SplineSegments);
+		return;
+	}
+	if (bBudgetCheckEnabled && !CheckGenerationBudget(World, PoleLocations, NumSocketsPerPole, Settings)) return;
+
+	ExecuteGeneration(World, PoleLocations, SocketLocations, NumSocketsPerPole, Settings, OutResult, PoleRefs);
+}
+
+void UPowerlineGenerationSubsystem::ExecuteGeneration(UWorld* World, TArrayView<const FVector> PoleLocations, TArrayView<const FVector> SocketLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, FPowerlineGenerationResult& OutResult, TArrayView<const FPowerlinePoleRef> PoleRefs)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const uint64 StartAllocations = GetNumHeapAllocations();
+	const int32 FirstCreatedActor = OutResult.CreatedActors.Num();
+
+	BeginNetworkRecording(World, PoleLocations, PoleRefs, NumSocketsPerPole, Settings);
+	if (Settings.bRuntimeStreaming)
+	{
+		GenerateStreamingSpans(World, PoleLocations, SocketLocations, NumSocketsPerPole, Settings, OutResult);
+	}
+	else if (Settings.bContinuousCables)
+	{
+		GenerateContinuousCables(World, PoleLocations, SocketLocations, NumSocketsPerPole, Settings, OutResult);
+	}
+	else
+	{
+		GenerateSpanActors(World, PoleLocations, SocketLocations, NumSocketsPerPole, Settings, OutResult);
+	}
+	EndNetworkRecording();
+	AddToCostReport(World, MakeArrayView(OutResult.CreatedActors).RightChop(FirstCreatedActor));
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+	const int32 NumComponents = OutResult.NumSplineComponents + OutResult.NumSplineMeshComponents;
+	if (NumComponents > 0)
+	{
+		SecondsPerComponent = Seconds / NumComponents;
+	}
+
+	OutResult.GenerateSeconds += Seconds;
+	OutResult.NumHeapAllocations += GetNumHeapAllocations() - StartAllocations;
+	OutResult.bSuccess = true;
+	UE_LOG(LogTemp, Log, TEXT("Created %d powerline spans in %d actors in %.3fs"), OutResult.NumSpans, OutResult.CreatedActors.Num(), OutResult.GenerateSeconds);
+}
+
+float UPowerlineGenerationSubsystem::GetLineBendOffset(int32 Index, const FPowerlineGenerationSettings& Settings)
+{
+	return FPowerlineCableMath::GetSagOffset(Index, Settings.SplineSegments, Settings.LineBend);
+}
+
+float UPowerlineGenerationSubsystem::GetSpanSag(const FVector& SpanStart, const FVector& SpanEnd, const FPowerlineGenerationSettings& Settings)
+{
+	if (!Settings.bUseConductorProfile) return Settings.LineBend;
+
+	if (!SagTable.IsBuiltFor(Settings.ConductorProfile))
+	{
+		SagTable.Build(Settings.ConductorProfile);
+	}
+	return SagTable.GetSag(SpanStart, SpanEnd);
+}
+
+uint64 UPowerlineGenerationSubsystem::GetNumHeapAllocations()
+{
+#if !UE_BUILD_SHIPPING
+	return FMalloc::TotalMallocCalls + FMalloc::TotalReallocCalls;
+#else
+	return 0;
+#endif
+}
+
+UPowerlineNetworkGraph* UPowerlineGenerationSubsystem::GetNetworkGraph(UWorld* World, bool bCreate) const
+{
+	if (!World || !World->PersistentLevel) return nullptr;
+
+	// Unsaved levels have no package to put the graph next to yet
+	const FString LevelPackageName = World->PersistentLevel->GetPackage()->GetName();
+	if (FPackageName::IsTempPackage(LevelPackageName)) return nullptr;
+
+	const FString GraphPackageName = LevelPackageName + TEXT("_PowerlineNetwork");
+	const FString GraphName = FPackageName::GetShortName(GraphPackageName);
+	const FString GraphPath = GraphPackageName + TEXT(".") + GraphName;
+	if (UPowerlineNetworkGraph* Graph = FindObject<UPowerlineNetworkGraph>(nullptr, *GraphPath))
+	{
+		return Graph;
+	}
+	if (FPackageName::DoesPackageExist(GraphPackageName))
+	{
+		return LoadObject<UPowerlineNetworkGraph>(nullptr, *GraphPath);
+	}
+	if (!bCreate || !GetDefault<UPowerlineToolSettings>()->bMaintainNetworkGraph) return nullptr;
+
+	UPackage* GraphPackage = CreatePackage(*GraphPackageName);
+	UPowerlineNetworkGraph* Graph = NewObject<UPowerlineNetworkGraph>(GraphPackage, *GraphName, RF_Public | RF_Standalone | RF_Transactional);
+	FAssetRegistryModule::AssetCreated(Graph);
+	return Graph;
+}
+
+void UPowerlineGenerationSubsystem::OnLevelActorDeleted(AActor* Actor)
+{
+	if (PowerlineGenerationSubsystem::HasCableComponents(Actor))
+	{
+		bCostReportDirty = true;
+	}
+
+	// Only cable actors are worth a graph lookup, pole deletions leave their spans dangling until the cables go too
+	if (!Actor || (!Actor->FindComponentByClass<USplineComponent>() && !Actor->FindComponentByClass<UPowerlineStreamingComponent>())) return;
+
+	if (UPowerlineNetworkGraph* Graph = GetNetworkGraph(Actor->GetWorld()))
+	{
+		if (!Graph->FindCableSpans(Actor).IsEmpty())
+		{
+			Graph->Modify();
+			Graph->RemoveCableActor(Actor);
+		}
+	}
+}
+
+void UPowerlineGenerationSubsystem::OnLevelActorAdded(AActor* Actor)
+{
+	// Cables spawned by the tool have no components yet when they are added, they reach the cost report through AddToCostReport
+	if (PowerlineGenerationSubsystem::HasCableComponents(Actor))
+	{
+		bCostReportDirty = true;
+	}
+	IndexCableActor(Actor);
+}
+
+bool UPowerlineGenerationSubsystem::CheckGenerationBudget(UWorld* World, TArrayView<const FVector> PoleLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings)
+{
+	TArray<FString> Violations;
+	GetBudgetViolations(World, PoleLocations, NumSocketsPerPole, Settings, Violations);
+	if (Violations.IsEmpty()) return true;
+
+	const bool bRefuse = GetDefault<UPowerlineToolSettings>()->BudgetAction == EPowerlineBudgetAction::Refuse;
+	for (const FString& Violation : Violations)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Generating %d spans would exceed the cable budget of %s: %s"), PoleLocations.Num() - 1, *World->GetName(), *Violation);
+	}
+	if (bRefuse)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Powerline generation refused, see the cable budget in Project Settings > Plugins > Powerline Tool"));
+	}
+	return !bRefuse;
+}
+
+void UPowerlineGenerationSubsystem::GetBudgetViolations(UWorld* World, TArrayView<const FVector> PoleLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, TArray<FString>& OutViolations)
+{
+	const UPowerlineToolSettings* ToolSettings = GetDefault<UPowerlineToolSettings>();
+	if (ToolSettings->BudgetAction == EPowerlineBudgetAction::Ignore) return;
+
+	UpdateCostReport(World);
+	const FPowerlineCost Planned = FPowerlineCostAnalyzer::EstimateGeneration(PoleLocations.Num() - 1, NumSocketsPerPole, Settings, CostReport.Get());
+	TMap<FIntPoint, FPowerlineCost> PlannedCells;
+	FPowerlineCostAnalyzer::EstimateGenerationCells(PoleLocations, NumSocketsPerPole, Settings, CostReport->CellSize, PlannedCells);
+	FPowerlineCostAnalyzer::CheckBudget(*CostReport, ToolSettings->GetBudget(World), OutViolations, Planned, &PlannedCells);
+}
+
+void UPowerlineGenerationSubsystem::UpdateCostReport(UWorld* World)
+{
+	const float CellSize = FMath::Max(GetDefault<UPowerlineToolSettings>()->ReportCellSize, 1.f);
+	if (CostReport && !bCostReportDirty && CostReportWorld.Get() == World && CostReport->CellSize == CellSize) return;
+
+	CostReport = MakeShared<FPowerlineCostReport>();
+	CostReportWorld = World;
+	bCostReportDirty = false;
+	FPowerlineCostAnalyzer::GatherWorld(World, CellSize, *CostReport);
+}
+
+void UPowerlineGenerationSubsystem::AddToCostReport(UWorld* World, TArrayView<const TObjectPtr<AActor>> Actors)
+{
+	if (!CostReport || bCostReportDirty || World != CostReportWorld.Get()) return;
+
+	for (AActor* Actor : Actors)
+	{
+		FPowerlineCostAnalyzer::AddActor(Actor, *CostReport);
+	}
+}
+
+void UPowerlineGenerationSubsystem::EstimatePlan(FPowerlineGenerationPlan& Plan)
+{
+	UWorld* World = Plan.World.Get();
+	Plan.NumPoles = Plan.PoleLocations.Num();
+	if (!World || Plan.NumPoles < 2 || Plan.NumSocketsPerPole < 1 || Plan.SocketLocations.Num() != Plan.NumPoles * Plan.NumSocketsPerPole)
+	{
+		Plan.Error = TEXT("Powerline generation needs atleast 2 poles with matching socket locations");
+		return;
+	}
+	if (Plan.Settings.SplineSegments < 1)
+	{
+		Plan.Error = FString::Printf(TEXT("Powerline generation needs atleast 1 spline segment per span, got %d"), Plan.Settings.SplineSegments);
+		return;
+	}
+
+	Plan.NumSpans = Plan.NumPoles - 1;
+	UpdateCostReport(World);
+	const FPowerlineCost Cost = FPowerlineCostAnalyzer::EstimateGeneration(Plan.NumSpans, Plan.NumSocketsPerPole, Plan.Settings, CostReport.Get());
+	Plan.PredictedActors = Cost.NumActors;
+	Plan.PredictedComponents = Cost.NumComponents;
+	Plan.PredictedTriangles = Cost.NumTriangles;
+	Plan.PredictedDrawCalls = Cost.NumDrawCalls;
+	Plan.PredictedRenderMemoryMB = Cost.RenderMemoryBytes / (1024.f * 1024.f);
+	Plan.PredictedPhysicsMemoryMB = Cost.PhysicsMemoryBytes / (1024.f * 1024.f);
+	Plan.EstimatedSeconds = FMath::Max(Cost.NumSplineComponents + Cost.NumSplineMeshComponents, Cost.NumStreamedSpans) * SecondsPerComponent;
+
+	GetBudgetViolations(World, Plan.PoleLocations, Plan.NumSocketsPerPole, Plan.Settings, Plan.BudgetViolations);
+	Plan.bRefusedByBudget = !Plan.BudgetViolations.IsEmpty() && GetDefault<UPowerlineToolSettings>()->BudgetAction == EPowerlineBudgetAction::Refuse;
+	Plan.bValid = true;
+}
+
+void UPowerlineGenerationSubsystem::GenerateSpanActors(UWorld* World, TArrayView<const FVector> PoleLocations, TArrayView<const FVector> SocketLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, FPowerlineGenerationResult& OutResult)
+{
+	const int32 NumPoles = PoleLocations.Num();
+	OutResult.CreatedActors.Reserve(OutResult.CreatedActors.Num() + NumPoles - 1);
+	for (int32 PoleNum = 0; PoleNum < NumPoles - 1; PoleNum++)
+	{
+		const FActorSpawnParameters SpawnParameters = MakeSpawnParameters();
+		AActor* CableActor = World->SpawnActor<AActor>(AActor::StaticClass(), FVector(0.f, 0.f, 0.f), FRotator(0.f, 0.f, 0.f), SpawnParameters);
+		if (!CableActor) continue;
+
+		CreateRootComponent(CableActor);
+		CableActor->SetActorLocation(PoleLocations[PoleNum]);
+		CableActor->SetIsSpatiallyLoaded(true);
+
+		if (Settings.bCompactStorage)
+		{
+			CreateCompactCables(CableActor, PoleNum, SocketLocations, NumSocketsPerPole, Settings, OutResult);
+		}
+		else
+		{
+			for (int32 Index = 0; Index < NumSocketsPerPole; Index++)
+			{
+				const int32 SocketIndex = PoleNum * NumSocketsPerPole + Index;
+				const int32 FirstComponent = CableActor->GetInstanceComponents().Num();
+				USplineComponent* SplineComp = CreateSplineComponent(CableActor);
+				if (!SplineComp) continue;
+
+				SetSplinePoints(SplineComp, SocketLocations[SocketIndex + NumSocketsPerPole], SocketLocations[SocketIndex], Settings);
+				OutResult.NumSplineMeshComponents += CreateSplineMeshComponents(SplineComp, CableActor, Settings);
+				OutResult.NumSplineComponents++;
+				RecordSpan(PoleNum, Index, CableActor, TConstArrayView<UActorComponent*>(CableActor->GetInstanceComponents()).RightChop(FirstComponent));
+			}
+		}
+
+		if (Settings.CollisionPolicy == EPowerlineCollisionPolicy::CapsuleChain)
+		{
+			CreateCollisionComponent(CableActor);
+		}
+
+		if (Settings.bAddWindComponent)
+		{
+			UPowerlineWindComponent* WindComp = NewObject<UPowerlineWindComponent>(CableActor);
+			WindComp->RegisterComponent();
+			CableActor->AddInstanceComponent(WindComp);
+		}
+
+		IndexCableActor(CableActor);
+		OutResult.CreatedActors.Add(CableActor);
+		OutResult.NumSpans++;
+	}
+}
+
+void UPowerlineGenerationSubsystem::CreateCompactCables(AActor* CableActor, int32 PoleNum, TArrayView<const FVector> SocketLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, FPowerlineGenerationResult& OutResult)
+{
+	UPowerlineCompactCableComponent* CompactComp = NewObject<UPowerlineCompactCableComponent>(CableActor);
+	CompactComp->SetupAttachment(CableActor->GetRootComponent());
+	CompactComp->SetMobility(EComponentMobility::Static);
+	CompactComp->CableMesh = Settings.CableMesh;
+	CompactComp->bSegmentCollision = Settings.CollisionPolicy == EPowerlineCollisionPolicy::PerSegment;
+	CompactComp->RegisterComponent();
+	CableActor->AddInstanceComponent(CompactComp);
+
+	TArray<FVector, TInlineAllocator<32>> Points;
+	Points.SetNumUninitialized(Settings.SplineSegments + 1);
+	for (int32 Index = 0; Index < NumSocketsPerPole; Index++)
+	{
+		const int32 SocketIndex = PoleNum * NumSocketsPerPole + Index;
+		const FVector& SpanStart = SocketLocations[SocketIndex + NumSocketsPerPole];
+		const FVector& SpanEnd = SocketLocations[SocketIndex];
+		FPowerlineCableMath::ComputeSpanPoints(SpanStart, SpanEnd, GetSpanSag(SpanStart, SpanEnd, Settings), Settings.SplineSegments, Points);
+
+		const int32 FirstSegment = CompactComp->GetSegments().Num();
+		CompactComp->AddCable(Points);
+		OutResult.NumSplineMeshComponents += CompactComp->GetSegments().Num() - FirstSegment;
+
+		TArray<UActorComponent*, TInlineAllocator<16>> SpanComponents;
+		SpanComponents.Add(CompactComp);
+		for (USplineMeshComponent* Segment : CompactComp->GetSegments().RightChop(FirstSegment))
+		{
+			SpanComponents.Add(Segment);
+		}
+		RecordSpan(PoleNum, Index, CableActor, SpanComponents);
+	}
+}
+
+void UPowerlineGenerationSubsystem::GenerateContinuousCables(UWorld* World, TArrayView<const FVector> PoleLocations, TArrayView<const FVector> SocketLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, FPowerlineGenerationResult& OutResult)
+{
+	const int32 NumPoles = PoleLocations.Num();
+	const int32 SpansPerActor = FMath::Max(1, Settings.ContinuousSpansPerActor);
+
+	// Neighbouring chunks share their boundary pole, every span belongs to exactly one actor
+	for (int32 FirstPole = 0; FirstPole < NumPoles - 1; FirstPole += SpansPerActor)
+	{
+		const int32 LastPole = FMath::Min(FirstPole + SpansPerActor, NumPoles - 1);
+
+		const FActorSpawnParameters SpawnParameters = MakeSpawnParameters();
+		AActor* CableActor = World->SpawnActor<AActor>(AActor::StaticClass(), FVector(0.f, 0.f, 0.f), FRotator(0.f, 0.f, 0.f), SpawnParameters);
+		if (!CableActor) continue;
+
+		CreateRootComponent(CableActor);
+		CableActor->SetActorLocation(PoleLocations[FirstPole]);
+		CableActor->SetIsSpatiallyLoaded(true);
+
+		for (int32 Track = 0; Track < NumSocketsPerPole; Track++)
+		{
+			const int32 FirstComponent = CableActor->GetInstanceComponents().Num();
+			USplineComponent* SplineComp = CreateSplineComponent(CableActor);
+			if (!SplineComp) continue;
+
+			SplineComp->ComponentTags.Add(PowerlineGenerationSubsystem::ContinuousCableTag);
+			SetContinuousSplinePoints(SplineComp, SocketLocations, FirstPole, LastPole, Track, NumSocketsPerPole, Settings);
+			OutResult.NumSplineMeshComponents += CreateSplineMeshComponents(SplineComp, CableActor, Settings);
+			OutResult.NumSplineComponents++;
+
+			// Every span owns the shared spline and its own SplineSegments meshes, starting from LastPole
+			const TConstArrayView<UActorComponent*> TrackMeshes = TConstArrayView<UActorComponent*>(CableActor->GetInstanceComponents()).RightChop(FirstComponent + 1);
+			for (int32 Pole = LastPole; Pole > FirstPole && RecordingGraph; Pole--)
+			{
+				TArray<UActorComponent*, TInlineAllocator<16>> SpanComponents;
+				SpanComponents.Add(SplineComp);
+				SpanComponents.Append(TrackMeshes.Mid((LastPole - Pole) * Settings.SplineSegments, Settings.SplineSegments));
+				RecordSpan(Pole - 1, Track, CableActor, SpanComponents);
+			}
+		}
+
+		if (Settings.CollisionPolicy == EPowerlineCollisionPolicy::CapsuleChain)
+		{
+			CreateCollisionComponent(CableActor);
+		}
+
+		if (Settings.bAddWindComponent)
+		{
+			// Each span sways on its own between the poles it hangs from
+			UPowerlineWindComponent* WindComp = NewObject<UPowerlineWindComponent>(CableActor);
+			WindComp->SegmentsPerCable = Settings.SplineSegments;
+			WindComp->RegisterComponent();
+			CableActor->AddInstanceComponent(WindComp);
+		}
+
+		IndexCableActor(CableActor);
+		OutResult.CreatedActors.Add(CableActor);
+		OutResult.NumSpans += LastPole - FirstPole;
+	}
+}
+
+void UPowerlineGenerationSubsystem::GenerateStreamingSpans(UWorld* World, TArrayView<const FVector> PoleLocations, TArrayView<const FVector> SocketLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, FPowerlineGenerationResult& OutResult)
+{
+	const FActorSpawnParameters SpawnParameters = MakeSpawnParameters();
+	AActor* StreamingActor = World->SpawnActor<AActor>(AActor::StaticClass(), FVector(0.f, 0.f, 0.f), FRotator(0.f, 0.f, 0.f), SpawnParameters);
+	if (!StreamingActor) return;
+
+	// The descriptors are small enough to keep the whole line always loaded, the component decides what gets built
+	UPowerlineStreamingComponent* StreamingComp = NewObject<UPowerlineStreamingComponent>(StreamingActor, TEXT("RootComponent"));
+	StreamingActor->SetRootComponent(StreamingComp);
+	StreamingComp->RegisterComponent();
+	StreamingActor->AddInstanceComponent(StreamingComp);
+	StreamingActor->SetActorLocation(PoleLocations[0]);
+	StreamingActor->SetIsSpatiallyLoaded(false);
+	StreamingComp->CableMesh = Settings.CableMesh;
+
+	const int32 NumPoles = PoleLocations.Num();
+	UActorComponent* const SpanComponent = StreamingComp;
+	for (int32 PoleNum = 0; PoleNum < NumPoles - 1; PoleNum++)
+	{
+		for (int32 Index = 0; Index < NumSocketsPerPole; Index++)
+		{
+			const int32 SocketIndex = PoleNum * NumSocketsPerPole + Index;
+			const FVector& SpanStart = SocketLocations[SocketIndex + NumSocketsPerPole];
+			const FVector& SpanEnd = SocketLocations[SocketIndex];
+			StreamingComp->AddSpan(SpanStart, SpanEnd, GetSpanSag(SpanStart, SpanEnd, Settings), Settings.SplineSegments);
+			RecordSpan(PoleNum, Index, StreamingActor, MakeArrayView(&SpanComponent, 1));
+		}
+		OutResult.NumSpans++;
+	}
+	IndexCableActor(StreamingActor);
+	OutResult.CreatedActors.Add(StreamingActor);
+}
+
+void UPowerlineGenerationSubsystem::CreateRootComponent(AActor* CableActor) const
+{
+	if (!CableActor->GetRootComponent())
+	{
+		USceneComponent* RootComp = NewObject<USceneComponent>(CableActor, TEXT("RootComponent"));
+		CableActor->SetRootComponent(RootComp);
+		CableActor->GetRootComponent()->SetMobility(EComponentMobility::Static);
+		RootComp->RegisterComponent();
+	}
+}
+
+USplineComponent* UPowerlineGenerationSubsystem::CreateSplineComponent(AActor* CableActor) const
+{
+	USplineComponent* SplineComp = NewObject<USplineComponent>(CableActor);
+	if (SplineComp)
+	{
+		SplineComp->SetupAttachment(CableActor->GetRootComponent());
+		SplineComp->RegisterComponent();
+		SplineComp->SetDrawDebug(false);
+		SplineComp->ComponentTags.Add(FPowerlineCookStripper::CableSplineTag);
+		CableActor->AddInstanceComponent(SplineComp);
+		return SplineComp;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Creating USplineComponent FAILED!"));
+	}
+	return nullptr;
+}
+
+void UPowerlineGenerationSubsystem::SetSplinePoints(USplineComponent* SplineComp, const FVector& SpanStart, const FVector& SpanEnd, const FPowerlineGenerationSettings& Settings)
+{
+	const int32 NumPoints = Settings.SplineSegments + 1;
+	const FTransform& ComponentTransform = SplineComp->GetComponentTransform();
+	const FVector PointDistance = (SpanEnd - SpanStart) / Settings.SplineSegments;
+	const float Sag = GetSpanSag(SpanStart, SpanEnd, Settings);
+
+	// Fill the curves in place with a single allocation each, AddSplinePoint reallocates and rebuilds the spline per point
+	FSplineCurves& Curves = SplineComp->SplineCurves;
+	Curves.Position.Points.Reset(NumPoints);
+	Curves.Rotation.Points.Reset(NumPoints);
+	Curves.Scale.Points.Reset(NumPoints);
+	for (int32 SplinePoint = 0; SplinePoint < NumPoints; SplinePoint++)
+	{
+		const FVector Location = SpanStart + PointDistance * SplinePoint + FVector(0.f, 0.f, FPowerlineCableMath::GetSagOffset(SplinePoint, Settings.SplineSegments, Sag));
+		const float InputKey = static_cast<float>(SplinePoint);
+		Curves.Position.Points.Emplace(InputKey, ComponentTransform.InverseTransformPosition(Location), FVector::ZeroVector, FVector::ZeroVector, CIM_CurveAuto);
+		Curves.Rotation.Points.Emplace(InputKey, FQuat::Identity, FQuat::Identity, FQuat::Identity, CIM_CurveAuto);
+		Curves.Scale.Points.Emplace(InputKey, FVector::OneVector, FVector::ZeroVector, FVector::ZeroVector, CIM_CurveAuto);
+	}
+	SplineComp->UpdateSpline();
+}
+
+void UPowerlineGenerationSubsystem::SetContinuousSplinePoints(USplineComponent* SplineComp, TArrayView<const FVector> SocketLocations, int32 FirstPole, int32 LastPole, int32 Track, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings)
+{
+	const int32 NumPoints = (LastPole - FirstPole) * Settings.SplineSegments + 1;
+	const FTransform& ComponentTransform = SplineComp->GetComponentTransform();
+
+	FSplineCurves& Curves = SplineComp->SplineCurves;
+	Curves.Position.Points.Reset(NumPoints);
+	Curves.Rotation.Points.Reset(NumPoints);
+	Curves.Scale.Points.Reset(NumPoints);
+	auto AddPoint = [&Curves, &ComponentTransform](const FVector& Location)
+		{
+			const float InputKey = static_cast<float>(Curves.Position.Points.Num());
+			Curves.Position.Points.Emplace(InputKey, ComponentTransform.InverseTransformPosition(Location), FVector::ZeroVector, FVector::ZeroVector, CIM_CurveAuto);
+			Curves.Rotation.Points.Emplace(InputKey, FQuat::Identity, FQuat::Identity, FQuat::Identity, CIM_CurveAuto);
+			Curves.Scale.Points.Emplace(InputKey, FVector::OneVector, FVector::ZeroVector, FVector::ZeroVector, CIM_CurveAuto);
+		};
+
+	// Same direction as the per span splines, from the later pole back to the earlier one, each span sagging on its own
+	for (int32 Pole = LastPole; Pole > FirstPole; Pole--)
+	{
+		const FVector& SpanStart = SocketLocations[Pole * NumSocketsPerPole + Track];
+		const FVector& SpanEnd = SocketLocations[(Pole - 1) * NumSocketsPerPole + Track];
+		const FVector PointDistance = (SpanEnd - SpanStart) / Settings.SplineSegments;
+		const float Sag = GetSpanSag(SpanStart, SpanEnd, Settings);
+		for (int32 SplinePoint = 0; SplinePoint < Settings.SplineSegments; SplinePoint++)
+		{
+			AddPoint(SpanStart + PointDistance * SplinePoint + FVector(0.f, 0.f, FPowerlineCableMath::GetSagOffset(SplinePoint, Settings.SplineSegments, Sag)));
+		}
+	}
+	AddPoint(SocketLocations[FirstPole * NumSocketsPerPole + Track]);
+	SplineComp->UpdateSpline();
+}
+
+void UPowerlineGenerationSubsystem::CreateCollisionComponent(AActor* CableActor) const
+{
+	UPowerlineCableCollisionComponent* CollisionComp = NewObject<UPowerlineCableCollisionComponent>(CableActor);
+	CollisionComp->SetupAttachment(CableActor->GetRootComponent());
+	CollisionComp->RegisterComponent();
+	CableActor->AddInstanceComponent(CollisionComp);
+
+	TInlineComponentArray<USplineMeshComponent*> SplineMeshes(CableActor);
+	CollisionComp->BuildFromSplineMeshes(SplineMeshes);
+}
+
+int32 UPowerlineGenerationSubsystem::CreateSplineMeshComponents(USplineComponent* SplineComp, AActor* CableActor, const FPowerlineGenerationSettings& Settings) const
+{
+	if (!Settings.CableMesh)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No CableMesh"));
+	}
+
+	const FName CollisionProfile = Settings.CollisionPolicy != EPowerlineCollisionPolicy::PerSegment ? UCollisionProfile::NoCollision_ProfileName : NAME_None;
+	int32 NumCreated = 0;
+	for (int32 Point = 0; Point <= SplineComp->GetNumberOfSplinePoints() - 2; Point++)
+	{
+		FVector StartLocation, StartTangent, EndLocation, EndTangent;
+		SplineComp->GetLocationAndTangentAtSplinePoint(Point, StartLocation, StartTangent, ESplineCoordinateSpace::Local);
+		SplineComp->GetLocationAndTangentAtSplinePoint(Point + 1, EndLocation, EndTangent, ESplineCoordinateSpace::Local);
+
+		USplineMeshComponent* SplineMeshComp = CreateSplineMeshComponent(SplineComp, CableActor, Settings.CableMesh, CollisionProfile);
+		if (SplineMeshComp)
+		{
+			SplineMeshComp->SetStartAndEnd(StartLocation, StartTangent, EndLocation, EndTangent);
+			NumCreated++;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SplineMeshComp not valid"));
+		}
+	}
+	return NumCreated;
+}
+
+USplineMeshComponent* UPowerlineGenerationSubsystem::CreateSplineMeshComponent(USplineComponent* SplineComp, AActor* CableActor, UStaticMesh* CableMesh, FName CollisionProfile) const
+{
+	// Transactional so segments created by ApplyParameters go away again on undo
+	USplineMeshComponent* SplineMeshComp = NewObject<USplineMeshComponent>(CableActor, USplineMeshComponent::StaticClass(), NAME_None, RF_Transactional);
+	if (!SplineMeshComp) return nullptr;
+
+	// Must be off before the first SetStartAndEnd, otherwise the deformed collision is cooked anyway
+	if (!CollisionProfile.IsNone())
+	{
+		SplineMeshComp->SetCollisionProfileName(CollisionProfile);
+	}
+
+	// The spline sits on the root without an offset, so its points are valid segment positions as they are
+	SplineMeshComp->AttachToComponent(SplineComp, FAttachmentTransformRules::KeepRelativeTransform);
+	SplineMeshComp->RegisterComponent();
+	CableActor->AddInstanceComponent(SplineMeshComp);
+	if (CableMesh)
+	{
+		SplineMeshComp->SetStaticMesh(CableMesh);
+	}
+	return SplineMeshComp;
+}
+
+UHierarchicalInstancedStaticMeshComponent* UPowerlineGenerationSubsystem::SpawnPoleInstances(UWorld* World, TArrayView<const FTransform> PoleTransforms, UStaticMesh* PoleMesh)
+{
+	// Thousands of poles stay one actor and one draw per mesh section
+	const FActorSpawnParameters SpawnParameters = MakeSpawnParameters();
+	AActor* PoleActor = World->SpawnActor<AActor>(AActor::StaticClass(), FVector(0.f, 0.f, 0.f), FRotator(0.f, 0.f, 0.f), SpawnParameters);
+	if (!PoleActor) return nullptr;
+
+	CreateRootComponent(PoleActor);
+	UHierarchicalInstancedStaticMeshComponent* PoleInstances = NewObject<UHierarchicalInstancedStaticMeshComponent>(PoleActor);
+	PoleInstances->SetupAttachment(PoleActor->GetRootComponent());
+	PoleInstances->SetMobility(EComponentMobility::Static);
+	PoleInstances->SetStaticMesh(PoleMesh);
+	PoleInstances->RegisterComponent();
+	PoleInstances->AddInstances(TArray<FTransform>(PoleTransforms), false, true);
+	PoleActor->AddInstanceComponent(PoleInstances);
+	return PoleInstances;
+}
+
+void UPowerlineGenerationSubsystem::SetShardActorPrefix(const FString& Prefix)
+{
+	ShardActorPrefix = Prefix;
+	NumShardActors = 0;
+}
+
+FActorSpawnParameters UPowerlineGenerationSubsystem::MakeSpawnParameters()
+{
+	FActorSpawnParameters SpawnParameters;
+	if (!ShardActorPrefix.IsEmpty())
+	{
+		// The external package of an actor is named after its path, so the name alone keeps shards apart
+		SpawnParameters.Name = FName(*ShardActorPrefix, ++NumShardActors);
+		SpawnParameters.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+	}
+	return SpawnParameters;
+}
+
+void UPowerlineGenerationSubsystem::BeginNetworkRecording(UWorld* World, TArrayView<const FVector> PoleLocations, TArrayView<const FPowerlinePoleRef> PoleRefs, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings)
+{
+	// Shards run in parallel processes, none of them may write the shared graph asset
+	if (!ShardActorPrefix.IsEmpty())
+	{
+		RecordingGraph = nullptr;
+		return;
+	}
+
+	RecordingGraph = Settings.NetworkGraph ? Settings.NetworkGraph.Get() : GetNetworkGraph(World, true);
+	RecordingPoles.Reset();
+	if (!RecordingGraph) return;
+
+	RecordingGraph->Modify();
+	RecordingPoles.SetNumUninitialized(PoleLocations.Num());
+	for (int32 Pole = 0; Pole < PoleLocations.Num(); Pole++)
+	{
+		const FPowerlinePoleRef PoleRef = PoleRefs.IsValidIndex(Pole) ? PoleRefs[Pole] : FPowerlinePoleRef();
+		RecordingPoles[Pole] = RecordingGraph->AddPole(PoleRef.Actor.Get(), PoleRef.Instances.Get(), PoleRef.InstanceIndex, PoleLocations[Pole], NumSocketsPerPole);
+	}
+}
+
+void UPowerlineGenerationSubsystem::RecordSpan(int32 PoleNum, int32 Socket, AActor* CableActor, TConstArrayView<UActorComponent*> Components)
+{
+	if (!RecordingGraph) return;
+
+	RecordingGraph->AddSpan(RecordingPoles[PoleNum + 1], RecordingPoles[PoleNum], Socket, CableActor, Components);
+}
+
+void UPowerlineGenerationSubsystem::EndNetworkRecording()
+{
+	if (!RecordingGraph) return;
+
+	UE_LOG(LogTemp, Log, TEXT("Network graph %s has %d poles and %d spans"), *RecordingGraph->GetName(), RecordingGraph->GetNumPoles(), RecordingGraph->GetNumSpans());
+	RecordingGraph->MarkPackageDirty();
+	RecordingGraph = nullptr;
+	RecordingPoles.Reset();
+}
@@ -0,0 +1,204 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineIntersectionChecker.h"
+#include "PowerlineCableBVH.h"
+#include "PowerlineCompactCableComponent.h"
+#include "PowerlineCookStripper.h"
+#include "PowerlineStreamingComponent.h"
+#include "EngineUtils.h"
+#include "Components/SplineComponent.h"
+#include "Components/SplineMeshComponent.h"
+#include "Engine/StaticMesh.h"
+
+namespace PowerlineIntersectionChecker
+{
+	// Keep the log readable on badly broken levels, the summary still counts everything
+	static constexpr int32 MaxLoggedIntersections = 200;
+
+	static float GetSegmentRadius(const USplineMeshComponent* SplineMeshComp)
+	{
+		const UStaticMesh* Mesh = SplineMeshComp->GetStaticMesh();
+		if (!Mesh) return 0.f;
+
+		// Cable meshes run along X, the cross section lies in the Y/Z plane
+		const FVector Extent = Mesh->GetBounds().BoxExtent;
+		const FVector2D Scale = SplineMeshComp->GetStartScale().ComponentMax(SplineMeshComp->GetEndScale());
+		const FVector ComponentScale = SplineMeshComp->GetComponentScale();
+		return FMath::Max(Extent.Y * Scale.X * ComponentScale.Y, Extent.Z * Scale.Y * ComponentScale.Z);
+	}
+
+	/**
+	 * Segments of generated splines and compact cables. Cables generated before segments were attached to their spline,
+	 * or saved with the splines stripped, keep them on the root of an actor with tagged cable splines.
+	 */
+	static bool IsCableSegment(const USplineMeshComponent* SplineMeshComp, bool bActorHasCableSplines)
+	{
+		const USceneComponent* Parent = SplineMeshComp->GetAttachParent();
+		if (!Parent) return false;
+		if (Parent->IsA<UPowerlineCompactCableComponent>() || Parent->ComponentHasTag(FPowerlineCookStripper::CableSplineTag)) return true;
+		return bActorHasCableSplines && Parent == SplineMeshComp->GetOwner()->GetRootComponent();
+	}
+
+	static bool OverlapsGeometry(const UPrimitiveComponent* Component, FVector Start, FVector End, float Radius, float AttachmentClearance)
+	{
+		const FBox Bounds = Component->Bounds.GetBox();
+		FVector Direction = End - Start;
+		float Length = Direction.Size();
+		if (Length < KINDA_SMALL_NUMBER) return false;
+		Direction /= Length;
+
+		// Cables are attached to sockets inside the pole mesh, ignore the part next to the socket
+		if (Bounds.IsInsideOrOn(Start))
+		{
+			Start += Direction * AttachmentClearance;
+			Length -= AttachmentClearance;
+		}
+		if (Bounds.IsInsideOrOn(End))
+		{
+			End -= Direction * AttachmentClearance;
+			Length -= AttachmentClearance;
+		}
+		if (Length <= 0.f) return false;
+
+		const FCollisionShape Capsule = FCollisionShape::MakeCapsule(Radius, Length * 0.5f + Radius);
+		const FQuat Rotation = FRotationMatrix::MakeFromZ(Direction).ToQuat();
+		return Component->OverlapComponent((Start + End) * 0.5f, Rotation, Capsule);
+	}
+}
+
+void FPowerlineIntersectionChecker::CheckWorld(UWorld* World, float Tolerance, float AttachmentClearance, FPowerlineIntersectionReport& OutReport)
+{
+	if (!World) return;
+
+	const double BuildStartTime = FPlatformTime::Seconds();
+
+	TArray<FPowerlineCableCapsule> Capsules;
+	TArray<AActor*> CableActors;
+	TArray<UStaticMeshComponent*> GeometryComponents;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AActor* Actor = *It;
+		auto GetOwnerIndex = [&CableActors, Actor]()
+			{
+				if (CableActors.IsEmpty() || CableActors.Last() != Actor)
+				{
+					CableActors.Add(Actor);
+				}
+				return CableActors.Num() - 1;
+			};
+
+		// Streamed spans are checked whether they are built or not, built segments of the component would count them twice
+		TInlineComponentArray<UPowerlineStreamingComponent*> StreamingComponents(Actor);
+		for (const UPowerlineStreamingComponent* StreamingComp : StreamingComponents)
+		{
+			const int32 FirstCapsule = Capsules.Num();
+			StreamingComp->GetSpanCapsules(Capsules);
+			for (int32 Capsule = FirstCapsule; Capsule < Capsules.Num(); Capsule++)
+			{
+				Capsules[Capsule].OwnerIndex = GetOwnerIndex();
+			}
+		}
+
+		TInlineComponentArray<USplineComponent*> Splines(Actor);
+		const bool bHasCableSplines = Splines.ContainsByPredicate([](const USplineComponent* SplineComp) { return SplineComp->ComponentHasTag(FPowerlineCookStripper::CableSplineTag); });
+
+		TInlineComponentArray<UStaticMeshComponent*> MeshComponents(Actor);
+		for (UStaticMeshComponent* MeshComponent : MeshComponents)
+		{
+			USplineMeshComponent* SplineMeshComp = Cast<USplineMeshComponent>(MeshComponent);
+			if (SplineMeshComp && SplineMeshComp->GetAttachParent() && SplineMeshComp->GetAttachParent()->IsA<UPowerlineStreamingComponent>()) continue;
+
+			if (!SplineMeshComp || !PowerlineIntersectionChecker::IsCableSegment(SplineMeshComp, bHasCableSplines))
+			{
+				if (MeshComponent->IsCollisionEnabled())
+				{
+					GeometryComponents.Add(MeshComponent);
+				}
+				continue;
+			}
+
+			const FTransform& ComponentTransform = SplineMeshComp->GetComponentTransform();
+			FPowerlineCableCapsule& Capsule = Capsules.AddDefaulted_GetRef();
+			Capsule.Start = ComponentTransform.TransformPosition(SplineMeshComp->GetStartPosition());
+			Capsule.End = ComponentTransform.TransformPosition(SplineMeshComp->GetEndPosition());
+			Capsule.Radius = PowerlineIntersectionChecker::GetSegmentRadius(SplineMeshComp);
+			Capsule.OwnerIndex = GetOwnerIndex();
+		}
+	}
+
+	OutReport.NumSegments = Capsules.Num();
+	OutReport.NumGeometryComponents = GeometryComponents.Num();
+
+	FPowerlineCableBVH BVH;
+	BVH.Build(MoveTemp(Capsules));
+
+	const double QueryStartTime = FPlatformTime::Seconds();
+	OutReport.BuildSeconds = QueryStartTime - BuildStartTime;
+
+	TArray<FPowerlineCapsulePair> Pairs;
+	BVH.FindCloseCapsulePairs(Tolerance, Pairs);
+
+	const TArray<FPowerlineCableCapsule>& BVHCapsules = BVH.GetCapsules();
+	OutReport.CableIntersections.Reserve(Pairs.Num());
+	for (const FPowerlineCapsulePair& Pair : Pairs)
+	{
+		FPowerlineIntersection& Intersection = OutReport.CableIntersections.AddDefaulted_GetRef();
+		Intersection.CableActor = CableActors[BVHCapsules[Pair.CapsuleA].OwnerIndex];
+		Intersection.OtherActor = CableActors[BVHCapsules[Pair.CapsuleB].OwnerIndex];
+		Intersection.Location = Pair.Location;
+		Intersection.Separation = Pair.Separation;
+		Intersection.bIntersecting = Pair.Separation < 0.f;
+	}
+
+	// Exact overlap tests go through the physics representation, so only the few BVH candidates are tested
+	TArray<int32> Candidates;
+	for (UStaticMeshComponent* GeometryComponent : GeometryComponents)
+	{
+		Candidates.Reset();
+		BVH.FindOverlappingCapsules(GeometryComponent->Bounds.GetBox().ExpandBy(Tolerance), Candidates);
+		for (int32 Candidate : Candidates)
+		{
+			const FPowerlineCableCapsule& Capsule = BVHCapsules[Candidate];
+			if (PowerlineIntersectionChecker::OverlapsGeometry(GeometryComponent, Capsule.Start, Capsule.End, Capsule.Radius + Tolerance, AttachmentClearance))
+			{
+				FPowerlineIntersection& Intersection = OutReport.GeometryIntersections.AddDefaulted_GetRef();
+				Intersection.CableActor = CableActors[Capsule.OwnerIndex];
+				Intersection.OtherActor = GeometryComponent->GetOwner();
+				Intersection.OtherComponent = GeometryComponent;
+				Intersection.Location = (Capsule.Start + Capsule.End) * 0.5f;
+				Intersection.bIntersecting = PowerlineIntersectionChecker::OverlapsGeometry(GeometryComponent, Capsule.Start, Capsule.End, Capsule.Radius, AttachmentClearance);
+			}
+		}
+	}
+
+	OutReport.QuerySeconds = FPlatformTime::Seconds() - QueryStartTime;
+}
+
+void FPowerlineIntersectionChecker::LogReport(const FPowerlineIntersectionReport& Report, float Tolerance)
+{
+	int32 NumLogged = 0;
+	for (const FPowerlineIntersection& Intersection : Report.CableIntersections)
+	{
+		if (NumLogged++ >= PowerlineIntersectionChecker::MaxLoggedIntersections) break;
+
+		UE_LOG(LogTemp, Warning, TEXT("%s: %s and %s at %s (separation %.1f)"),
+			Intersection.bIntersecting ? TEXT("Cables intersect") : TEXT("Cables nearly touch"),
+			Intersection.CableActor.IsValid() ? *Intersection.CableActor->GetActorNameOrLabel() : TEXT("None"),
+			Intersection.OtherActor.IsValid() ? *Intersection.OtherActor->GetActorNameOrLabel() : TEXT("None"),
+			*Intersection.Location.ToString(), Intersection.Separation);
+	}
+	for (const FPowerlineIntersection& Intersection : Report.GeometryIntersections)
+	{
+		if (NumLogged++ >= PowerlineIntersectionChecker::MaxLoggedIntersections) break;
+
+		UE_LOG(LogTemp, Warning, TEXT("%s: %s and %s at %s"),
+			Intersection.bIntersecting ? TEXT("Cable passes through geometry") : TEXT("Cable nearly touches geometry"),
+			Intersection.CableActor.IsValid() ? *Intersection.CableActor->GetActorNameOrLabel() : TEXT("None"),
+			Intersection.OtherActor.IsValid() ? *Intersection.OtherActor->GetActorNameOrLabel() : TEXT("None"),
+			*Intersection.Location.ToString());
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Cable check: %d segments, %d meshes, %d cable pairs and %d geometry hits closer than %.1f (build %.3fs, query %.3fs)"),
+		Report.NumSegments, Report.NumGeometryComponents, Report.CableIntersections.Num(), Report.GeometryIntersections.Num(),
+		Tolerance, Report.BuildSeconds, Report.QuerySeconds);
+}
@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPrimitiveComponent;
+
+struct FPowerlineIntersection
+{
+	TWeakObjectPtr<AActor> CableActor;
+
+	/** Other cable actor, or the actor owning OtherComponent for cable vs geometry hits. */
+	TWeakObjectPtr<AActor> OtherActor;
+	TWeakObjectPtr<UPrimitiveComponent> OtherComponent;
+
+	FVector Location = FVector::ZeroVector;
+
+	/** Surface to surface distance for cable pairs, negative when penetrating. Zero for geometry hits. */
+	float Separation = 0.f;
+
+	bool bIntersecting = false;
+};
+
+struct FPowerlineIntersectionReport
+{
+	TArray<FPowerlineIntersection> CableIntersections;
+	TArray<FPowerlineIntersection> GeometryIntersections;
+
+	int32 NumSegments = 0;
+	int32 NumGeometryComponents = 0;
+	double BuildSeconds = 0.0;
+	double QuerySeconds = 0.0;
+};
+
+/** Finds cables that cross each other or pass through other meshes in a world. */
+class FPowerlineIntersectionChecker
+{
+public:
+	/**
+	 * Collects the segments of generated cables and the spans of streaming components in World as capsules
+	 * and reports pairs closer than Tolerance. Other spline meshes count as geometry.
+	 * Cable ends are trimmed by AttachmentClearance where they enter a pole so the socket contact is not reported.
+	 */
+	static void CheckWorld(UWorld* World, float Tolerance, float AttachmentClearance, FPowerlineIntersectionReport& OutReport);
+
+	static void LogReport(const FPowerlineIntersectionReport& Report, float Tolerance);
+};
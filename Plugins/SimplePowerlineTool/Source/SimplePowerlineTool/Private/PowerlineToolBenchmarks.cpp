@@ -0,0 +1,452 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "PowerlineCableBVH.h"
+#include "PowerlineCableMath.h"
+#include "PowerlineCompactCable.h"
+#include "PowerlineExporter.h"
+#include "PowerlineGenerationSubsystem.h"
+#include "PowerlineSagTable.h"
+#include "PowerlineWindSimulation.h"
+#include "Editor.h"
+#include "Components/SplineComponent.h"
+#include "Components/SplineMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+namespace PowerlineToolBenchmarks
+{
+	static int32 ParseCount(const TArray<FString>& Args, int32 ArgIndex, int32 DefaultValue)
+	{
+		return Args.IsValidIndex(ArgIndex) ? FMath::Max(1, FCString::Atoi(*Args[ArgIndex])) : DefaultValue;
+	}
+
+	/** Synthetic network: parallel 6 socket runs of sagging cables spread over a square map. */
+	static TArray<FPowerlineCableCapsule> MakeSyntheticCapsules(int32 NumSegments)
+	{
+		const int32 SegmentsPerSpan = 10;
+		const int32 SocketsPerPole = 6;
+		const float SpanLength = 3000.f;
+		const float SegmentLength = SpanLength / SegmentsPerSpan;
+
+		FRandomStream Random(1234);
+		TArray<FPowerlineCableCapsule> Capsules;
+		Capsules.Reserve(NumSegments);
+		while (Capsules.Num() < NumSegments)
+		{
+			const FVector PoleLocation(Random.FRandRange(-1000000.f, 1000000.f), Random.FRandRange(-1000000.f, 1000000.f), 0.f);
+			const FVector Direction = FRotator(0.f, Random.FRandRange(0.f, 360.f), 0.f).Vector();
+			for (int32 Socket = 0; Socket < SocketsPerPole && Capsules.Num() < NumSegments; Socket++)
+			{
+				const FVector SocketOffset(0.f, (Socket % 3 - 1) * 80.f, 1000.f + (Socket / 3) * 100.f);
+				for (int32 Segment = 0; Segment < SegmentsPerSpan && Capsules.Num() < NumSegments; Segment++)
+				{
+					const float StartAlpha = float(Segment) / SegmentsPerSpan;
+					const float EndAlpha = float(Segment + 1) / SegmentsPerSpan;
+					FPowerlineCableCapsule& Capsule = Capsules.AddDefaulted_GetRef();
+					Capsule.Start = PoleLocation + SocketOffset + Direction * SegmentLength * Segment - FVector(0.f, 0.f, 400.f * StartAlpha * (1.f - StartAlpha));
+					Capsule.End = PoleLocation + SocketOffset + Direction * SegmentLength * (Segment + 1) - FVector(0.f, 0.f, 400.f * EndAlpha * (1.f - EndAlpha));
+					Capsule.Radius = 2.f;
+					Capsule.OwnerIndex = Capsules.Num() / (SegmentsPerSpan * SocketsPerPole);
+				}
+			}
+		}
+		return Capsules;
+	}
+
+	static void BenchmarkIntersections(const TArray<FString>& Args)
+	{
+		const int32 NumSegments = ParseCount(Args, 0, 100000);
+		TArray<FPowerlineCableCapsule> Capsules = MakeSyntheticCapsules(NumSegments);
+
+		const double BuildStartTime = FPlatformTime::Seconds();
+		FPowerlineCableBVH BVH;
+		BVH.Build(MoveTemp(Capsules));
+		const double QueryStartTime = FPlatformTime::Seconds();
+
+		TArray<FPowerlineCapsulePair> Pairs;
+		BVH.FindCloseCapsulePairs(10.f, Pairs);
+		const double EndTime = FPlatformTime::Seconds();
+
+		UE_LOG(LogTemp, Log, TEXT("Intersection benchmark: %d segments, %d nodes, %d pairs, build %.3fs, query %.3fs"),
+			NumSegments, BVH.GetNumNodes(), Pairs.Num(), QueryStartTime - BuildStartTime, EndTime - QueryStartTime);
+	}
+
+	/** Closest cable and sphere queries at random points over the synthetic network, on the calling thread only. */
+	static void BenchmarkQuery(const TArray<FString>& Args)
+	{
+		const int32 NumSegments = ParseCount(Args, 0, 100000);
+		const int32 NumQueries = ParseCount(Args, 1, 1000000);
+
+		FPowerlineCableBVH BVH;
+		BVH.Build(MakeSyntheticCapsules(NumSegments));
+
+		// Around random cables, points anywhere on the map would almost never find one
+		FRandomStream Random(4321);
+		const TArray<FPowerlineCableCapsule>& Capsules = BVH.GetCapsules();
+		TArray<FVector> QueryPoints;
+		QueryPoints.SetNumUninitialized(NumQueries);
+		for (FVector& Point : QueryPoints)
+		{
+			const FPowerlineCableCapsule& Capsule = Capsules[Random.RandHelper(Capsules.Num())];
+			Point = (Capsule.Start + Capsule.End) * 0.5f + FVector(Random.FRandRange(-3000.f, 3000.f), Random.FRandRange(-3000.f, 3000.f), Random.FRandRange(-1000.f, 1000.f));
+		}
+
+		const double ClosestStartTime = FPlatformTime::Seconds();
+		int32 NumFound = 0;
+		for (const FVector& Point : QueryPoints)
+		{
+			FPowerlineCapsuleHit Hit;
+			NumFound += BVH.FindClosestCapsule(Point, 5000.f, Hit) ? 1 : 0;
+		}
+		const double SphereStartTime = FPlatformTime::Seconds();
+
+		int64 NumSphereHits = 0;
+		TArray<FPowerlineCapsuleHit> Hits;
+		for (const FVector& Point : QueryPoints)
+		{
+			Hits.Reset();
+			BVH.FindCapsulesInSphere(Point, 500.f, Hits);
+			NumSphereHits += Hits.Num();
+		}
+		const double EndTime = FPlatformTime::Seconds();
+
+		const double ClosestSeconds = SphereStartTime - ClosestStartTime;
+		const double SphereSeconds = EndTime - SphereStartTime;
+		UE_LOG(LogTemp, Log, TEXT("Query benchmark: %d segments, %d queries, closest within 50 m %.2f M/s (%d found), sphere 5 m %.2f M/s (%lld hits)"),
+			NumSegments, NumQueries, NumQueries / FMath::Max(ClosestSeconds, 1e-9) / 1e6, NumFound, NumQueries / FMath::Max(SphereSeconds, 1e-9) / 1e6, NumSphereHits);
+	}
+
+	/** Generates a straight line of poles in a transient world so the level being edited is not touched. */
+	static void BenchmarkGeneration(const TArray<FString>& Args)
+	{
+		const int32 NumPoles = FMath::Max(2, ParseCount(Args, 0, 1000));
+		const int32 NumSockets = 6;
+
+		TArray<FVector> PoleLocations;
+		TArray<FVector> SocketLocations;
+		PoleLocations.Reserve(NumPoles);
+		SocketLocations.Reserve(NumPoles * NumSockets);
+		for (int32 Pole = 0; Pole < NumPoles; Pole++)
+		{
+			const FVector PoleLocation(Pole * 3000.f, 0.f, 0.f);
+			PoleLocations.Add(PoleLocation);
+			for (int32 Socket = 0; Socket < NumSockets; Socket++)
+			{
+				SocketLocations.Add(PoleLocation + FVector(0.f, (Socket % 3 - 1) * 80.f, 1000.f + (Socket / 3) * 100.f));
+			}
+		}
+
+		FPowerlineGenerationSettings Settings;
+		Settings.SplineSegments = ParseCount(Args, 1, 10);
+
+		UWorld* World = UWorld::CreateWorld(EWorldType::EditorPreview, false, TEXT("PowerlineBenchmark"));
+		FPowerlineGenerationResult Result;
+		GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->GeneratePowerlines(World, PoleLocations, SocketLocations, NumSockets, Settings, Result);
+		World->DestroyWorld(false);
+
+		const int32 NumComponentsPerSpan = Result.NumSpans > 0 ? (Result.NumSplineComponents + Result.NumSplineMeshComponents) / Result.NumSpans : 0;
+		UE_LOG(LogTemp, Log, TEXT("Generation benchmark: %d spans, %d components per span, %.3fs, %.1f heap allocations per span (%.1f per component)"),
+			Result.NumSpans, NumComponentsPerSpan, Result.GenerateSeconds,
+			Result.NumSpans > 0 ? double(Result.NumHeapAllocations) / Result.NumSpans : 0.0,
+			NumComponentsPerSpan > 0 ? double(Result.NumHeapAllocations) / (Result.NumSpans * NumComponentsPerSpan) : 0.0);
+	}
+
+	/** Places poles along a meandering guide spline of N km (default 50) in a transient world and connects them. */
+	static void BenchmarkPlacement(const TArray<FString>& Args)
+	{
+		const int32 RouteKilometers = ParseCount(Args, 0, 50);
+		UStaticMesh* PoleMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cylinder.Cylinder"));
+
+		UWorld* World = UWorld::CreateWorld(EWorldType::EditorPreview, false, TEXT("PowerlineBenchmark"));
+		AActor* RouteActor = World->SpawnActor<AActor>();
+		USplineComponent* GuideSpline = NewObject<USplineComponent>(RouteActor);
+		RouteActor->SetRootComponent(GuideSpline);
+		GuideSpline->RegisterComponent();
+		GuideSpline->ClearSplinePoints(false);
+		for (int32 Kilometer = 0; Kilometer <= RouteKilometers; Kilometer++)
+		{
+			GuideSpline->AddSplinePoint(FVector(Kilometer * 100000.f, (Kilometer % 2) * 20000.f, 0.f), ESplineCoordinateSpace::World, false);
+		}
+		GuideSpline->UpdateSpline();
+
+		FPowerlinePolePlacementSettings Placement;
+		Placement.PoleMesh = PoleMesh;
+		FPowerlineGenerationSettings Settings;
+		Settings.bContinuousCables = true;
+		const FPowerlineGenerationResult Result = GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->GenerateAlongSpline(GuideSpline, Placement, Settings);
+		World->DestroyWorld(false);
+
+		UE_LOG(LogTemp, Log, TEXT("Placement benchmark: %d km, %d poles placed in %.3fs, %d spans generated in %.3fs"),
+			RouteKilometers, Result.NumPlacedPoles, Result.PlacementSeconds, Result.NumSpans, Result.GenerateSeconds);
+	}
+
+	/** Random spans evaluated with the exact catenary solve and with the lookup table. */
+	static void BenchmarkSag(const TArray<FString>& Args)
+	{
+		const int32 NumSpans = ParseCount(Args, 0, 100000);
+
+		FPowerlineConductorProfile Profile;
+		Profile.Temperature = 40.f;
+		FRandomStream Random(1234);
+		TArray<FVector2f> Spans;
+		Spans.Reserve(NumSpans);
+		for (int32 Span = 0; Span < NumSpans; Span++)
+		{
+			Spans.Emplace(Random.FRandRange(1000.f, Profile.MaxSpanLength), Random.FRandRange(-Profile.MaxHeightDifference, Profile.MaxHeightDifference));
+		}
+
+		const double BuildStartTime = FPlatformTime::Seconds();
+		FPowerlineSagTable Table;
+		Table.Build(Profile);
+		const double ExactStartTime = FPlatformTime::Seconds();
+
+		TArray<float> ExactSags;
+		ExactSags.Reserve(NumSpans);
+		for (const FVector2f& Span : Spans)
+		{
+			ExactSags.Add(FPowerlineSagTable::ComputeSag(Profile, Span.X, Span.Y));
+		}
+		const double TableStartTime = FPlatformTime::Seconds();
+
+		float MaxError = 0.f;
+		for (int32 Span = 0; Span < NumSpans; Span++)
+		{
+			MaxError = FMath::Max(MaxError, FMath::Abs(Table.GetSag(Spans[Span].X, Spans[Span].Y) - ExactSags[Span]));
+		}
+		const double EndTime = FPlatformTime::Seconds();
+
+		UE_LOG(LogTemp, Log, TEXT("Sag benchmark: %d spans, table build %.3fs, exact %.3fs, table %.3fs, max error %.2f cm"),
+			NumSpans, ExactStartTime - BuildStartTime, TableStartTime - ExactStartTime, EndTime - TableStartTime, MaxError);
+	}
+
+	/** Random sagging spans quantized and decoded again, compared against the spline and spline mesh data they replace. */
+	static void BenchmarkCompact(const TArray<FString>& Args)
+	{
+		const int32 NumSpans = ParseCount(Args, 0, 100000);
+		const int32 NumSegments = ParseCount(Args, 1, 10);
+
+		FRandomStream Random(1234);
+		TArray<FVector> Points;
+		TArray<FVector> Decoded;
+		Points.SetNumUninitialized(NumSegments + 1);
+		Decoded.SetNumUninitialized(NumSegments + 1);
+		TArray<FPowerlineCompactCable> Cables;
+		Cables.SetNum(NumSpans);
+
+		double MaxError = 0.0;
+		float MaxBound = 0.f;
+		double EncodeSeconds = 0.0;
+		double DecodeSeconds = 0.0;
+		for (FPowerlineCompactCable& Cable : Cables)
+		{
+			// Cables are stored relative to their actor, which sits on the first pole of the span
+			const FVector Start(0.f, 0.f, Random.FRandRange(500.f, 5000.f));
+			const FVector End = Start + FRotator(0.f, Random.FRandRange(0.f, 360.f), 0.f).Vector() * Random.FRandRange(1000.f, 30000.f) + FVector(0.f, 0.f, Random.FRandRange(-1000.f, 1000.f));
+			FPowerlineCableMath::ComputeSpanPoints(Start, End, Random.FRandRange(10.f, 1000.f), NumSegments, Points);
+
+			const double EncodeStartTime = FPlatformTime::Seconds();
+			Cable.Encode(Points);
+			const double DecodeStartTime = FPlatformTime::Seconds();
+			Cable.Decode(Decoded);
+			const double EndTime = FPlatformTime::Seconds();
+			EncodeSeconds += DecodeStartTime - EncodeStartTime;
+			DecodeSeconds += EndTime - DecodeStartTime;
+
+			for (int32 Point = 0; Point <= NumSegments; Point++)
+			{
+				MaxError = FMath::Max(MaxError, (Decoded[Point] - Points[Point]).GetAbsMax());
+			}
+			MaxBound = FMath::Max(MaxBound, Cable.GetMaxError());
+		}
+
+		// Per span the curves of a spline component and one spline mesh segment per spline segment
+		const SIZE_T FullBytesPerSpan = (NumSegments + 1) * (2 * sizeof(FInterpCurvePoint<FVector>) + sizeof(FInterpCurvePoint<FQuat>)) + NumSegments * sizeof(FSplineMeshParams);
+		SIZE_T CompactBytes = 0;
+		for (const FPowerlineCompactCable& Cable : Cables)
+		{
+			CompactBytes += sizeof(FPowerlineCompactCable) + Cable.Offsets.GetAllocatedSize();
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("Compact benchmark: %d spans, %d segments, %.1f bytes per span instead of %d (%.1fx smaller), encode %.3fs, decode %.3fs, max error %.4f cm (bound %.4f cm, float endpoints add a little)"),
+			NumSpans, NumSegments, double(CompactBytes) / NumSpans, int32(FullBytesPerSpan), double(FullBytesPerSpan) * NumSpans / CompactBytes,
+			EncodeSeconds, DecodeSeconds, MaxError, MaxBound);
+	}
+
+	/** Generates N poles of cables in a transient world and exports them as meshes and as centre lines in one format. */
+	static void BenchmarkExport(const TArray<FString>& Args)
+	{
+		const int32 NumPoles = FMath::Max(2, ParseCount(Args, 0, 1000));
+		const int32 NumSockets = 6;
+		const EPowerlineExportFormat Format = Args.IsValidIndex(1) && Args[1].Equals(TEXT("gltf"), ESearchCase::IgnoreCase) ? EPowerlineExportFormat::Gltf : EPowerlineExportFormat::Obj;
+
+		TArray<FVector> PoleLocations;
+		TArray<FVector> SocketLocations;
+		for (int32 Pole = 0; Pole < NumPoles; Pole++)
+		{
+			const FVector PoleLocation(Pole * 3000.f, 0.f, 0.f);
+			PoleLocations.Add(PoleLocation);
+			for (int32 Socket = 0; Socket < NumSockets; Socket++)
+			{
+				SocketLocations.Add(PoleLocation + FVector(0.f, (Socket % 3 - 1) * 80.f, 1000.f + (Socket / 3) * 100.f));
+			}
+		}
+
+		FPowerlineGenerationSettings Settings;
+		Settings.CableMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cylinder.Cylinder"));
+		Settings.SplineSegments = 10;
+		Settings.CollisionPolicy = EPowerlineCollisionPolicy::None;
+
+		UWorld* World = UWorld::CreateWorld(EWorldType::EditorPreview, false, TEXT("PowerlineBenchmark"));
+		FPowerlineGenerationResult Result;
+		GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->GeneratePowerlines(World, PoleLocations, SocketLocations, NumSockets, Settings, Result);
+
+		const FString Filename = FPaths::ProjectSavedDir() / (Format == EPowerlineExportFormat::Gltf ? TEXT("PowerlineBenchmark.gltf") : TEXT("PowerlineBenchmark.obj"));
+		for (const bool bCenterlines : { false, true })
+		{
+			FPowerlineExportOptions Options;
+			Options.Format = Format;
+			Options.bCenterlines = bCenterlines;
+			FPowerlineExporter Exporter(Filename, Options);
+			for (TActorIterator<AActor> It(World); It; ++It)
+			{
+				Exporter.AddActor(*It);
+			}
+
+			FPowerlineExportStats Stats;
+			Exporter.Finish(Stats);
+			const double Megabytes = Stats.NumBytes / (1024.0 * 1024.0);
+			UE_LOG(LogTemp, Log, TEXT("Export benchmark (%s): %d spans, %lld vertices, %lld triangles, %lld lines, %.1f MB in %.3fs, %.1f MB/s"),
+				bCenterlines ? TEXT("centre lines") : TEXT("meshes"), Result.NumSpans, Stats.NumVertices, Stats.NumTriangles, Stats.NumLines,
+				Megabytes, Stats.Seconds, Stats.Seconds > 0.0 ? Megabytes / Stats.Seconds : 0.0);
+		}
+		World->DestroyWorld(false);
+
+		IFileManager::Get().Delete(*Filename);
+		IFileManager::Get().Delete(*FPaths::ChangeExtension(Filename, TEXT("bin")));
+	}
+
+	/**
+	 * Checks the wind simulation headlessly: pinned ends must not move and a steady wind must settle the middle of the span
+	 * at wind / stiffness. Also times N cables (default 10000) and logs how far a variable tick rate drifts from a fixed one.
+	 */
+	static void BenchmarkWind(const TArray<FString>& Args)
+	{
+		const int32 NumCables = ParseCount(Args, 0, 10000);
+		const int32 NumPoints = 11;
+		const float Sag = 200.f;
+
+		TArray<FVector> Points;
+		Points.SetNumUninitialized(NumPoints);
+		FPowerlineCableMath::ComputeSpanPoints(FVector(0.f, 0.f, 1000.f), FVector(5000.f, 0.f, 1000.f), Sag, NumPoints - 1, Points);
+		TArray<FVector3f> RestPoints;
+		float RestSag = 0.f;
+		for (const FVector& Point : Points)
+		{
+			RestPoints.Add(FVector3f(Point));
+			RestSag = FMath::Max(RestSag, 1000.f - float(Point.Z));
+		}
+
+		FPowerlineWindSimulation::FSettings Settings;
+		Settings.Gustiness = 0.f;
+		Settings.Damping = 2.f;
+		Settings.FullRateDistance = 1.e7f;
+		Settings.MaxDistance = 2.e7f;
+
+		// A steady wind against the pendulum pull settles at Wind / stiffness, read from the simulation so the check follows its constants
+		auto MakeSimulation = [&](int32 Count)
+			{
+				TUniquePtr<FPowerlineWindSimulation> Simulation = MakeUnique<FPowerlineWindSimulation>();
+				Simulation->SetSettings(Settings);
+				for (int32 Cable = 0; Cable < Count; Cable++)
+				{
+					Simulation->AddCable(RestPoints);
+				}
+				return Simulation;
+			};
+		const FVector3f Expected = Settings.Wind / FPowerlineWindSimulation::GetStiffness(RestSag);
+		const FVector3f ViewLocation = RestPoints[NumPoints / 2];
+
+		TUniquePtr<FPowerlineWindSimulation> Fixed = MakeSimulation(NumCables);
+		TUniquePtr<FPowerlineWindSimulation> Variable = MakeSimulation(1);
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Tick = 0; Tick < 60; Tick++)
+		{
+			Fixed->Tick(1.f / 60.f, ViewLocation);
+		}
+		const double TickSeconds = (FPlatformTime::Seconds() - StartTime) / 60.0;
+		for (int32 Tick = 0; Tick < 24; Tick++)
+		{
+			Variable->Tick(1.f / 30.f, ViewLocation);
+			Variable->Tick(1.f / 120.f, ViewLocation);
+		}
+		const float RateDrift = FVector3f::Dist(FVector3f(Fixed->GetCableOffsets(0)[NumPoints / 2]), FVector3f(Variable->GetCableOffsets(0)[NumPoints / 2]));
+
+		for (int32 Tick = 0; Tick < 60 * 29; Tick++)
+		{
+			Fixed->Tick(1.f / 60.f, ViewLocation);
+		}
+
+		float MaxEndOffset = 0.f;
+		float MaxMidError = 0.f;
+		for (int32 Cable = 0; Cable < NumCables; Cable++)
+		{
+			const TConstArrayView<FVector4f> Offsets = Fixed->GetCableOffsets(Cable);
+			MaxEndOffset = FMath::Max3(MaxEndOffset, FVector3f(Offsets[0]).Size(), FVector3f(Offsets.Last()).Size());
+			MaxMidError = FMath::Max(MaxMidError, FVector3f::Dist(FVector3f(Offsets[NumPoints / 2]), Expected));
+		}
+
+		const bool bPassed = MaxEndOffset == 0.f && MaxMidError <= Expected.Size() * 0.01f;
+		UE_LOG(LogTemp, Log, TEXT("Wind benchmark: %d cables of %d points, %.3f ms per tick, pinned end offset %.4f cm, mid span %.2f cm from the %.2f cm equilibrium, 30/120 Hz ticks drift %.2f cm from 60 Hz after 1s"),
+			NumCables, NumPoints, TickSeconds * 1000.0, MaxEndOffset, MaxMidError, Expected.Size(), RateDrift);
+		if (!bPassed)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Wind check failed: pinned ends must stay at zero and the mid span must settle within 1%% of the equilibrium"));
+		}
+	}
+
+	static FAutoConsoleCommand BenchmarkIntersectionsCommand(
+		TEXT("PowerlineTool.Benchmark.Intersections"),
+		TEXT("Builds the cable BVH over N synthetic segments (default 100000) and times the intersection query."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkIntersections));
+
+	static FAutoConsoleCommand BenchmarkQueryCommand(
+		TEXT("PowerlineTool.Benchmark.Query"),
+		TEXT("Runs M (default 1000000) closest cable and sphere queries on one thread against N synthetic segments (default 100000), reports millions of queries per second."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkQuery));
+
+	static FAutoConsoleCommand BenchmarkGenerationCommand(
+		TEXT("PowerlineTool.Benchmark.Generation"),
+		TEXT("Generates cables for N poles (default 1000) with 6 sockets and M segments (default 10) in a transient world, reports time and heap allocations per span."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkGeneration));
+
+	static FAutoConsoleCommand BenchmarkPlacementCommand(
+		TEXT("PowerlineTool.Benchmark.Placement"),
+		TEXT("Places poles every 50 m along an N km guide spline (default 50) in a transient world and connects them with continuous cables."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkPlacement));
+
+	static FAutoConsoleCommand BenchmarkSagCommand(
+		TEXT("PowerlineTool.Benchmark.Sag"),
+		TEXT("Computes conductor sag for N random spans (default 100000) exactly and through the sag table, reports both times and the table error."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkSag));
+
+	static FAutoConsoleCommand BenchmarkCompactCommand(
+		TEXT("PowerlineTool.Benchmark.Compact"),
+		TEXT("Quantizes N random spans (default 100000) of M segments (default 10), reports bytes per span against spline components and the reconstruction error."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkCompact));
+
+	static FAutoConsoleCommand BenchmarkExportCommand(
+		TEXT("PowerlineTool.Benchmark.Export"),
+		TEXT("Generates cables for N poles (default 1000) with 6 sockets in a transient world and exports them to Saved as OBJ, or glTF when the second argument is gltf, reports MB/s."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkExport));
+
+	static FAutoConsoleCommand BenchmarkWindCommand(
+		TEXT("PowerlineTool.Benchmark.Wind"),
+		TEXT("Simulates N cables (default 10000) in a steady wind for 30s, checks that pinned ends stay put and the mid span settles at the wind equilibrium, reports time per tick."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkWind));
+}
@@ -0,0 +1,545 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineToolCommandlet.h"
+#include "PowerlineCostReport.h"
+#include "PowerlineExporter.h"
+#include "PowerlineGenerationSubsystem.h"
+#include "PowerlineNetworkGraph.h"
+#include "PowerlineToolSettings.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/SplineComponent.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "FileHelpers.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Paths.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+#include "WorldPartition/WorldPartitionActorDescInstance.h"
+#include "WorldPartition/LoaderAdapter/LoaderAdapterShape.h"
+
+namespace PowerlineToolCommandlet
+{
+	static UWorld* LoadWorld(const FString& MapName)
+	{
+		UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+		UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+		if (!World) return nullptr;
+
+		World->AddToRoot();
+		World->WorldType = EWorldType::Editor;
+		if (!World->bIsWorldInitialized)
+		{
+			UWorld::InitializationValues InitValues;
+			InitValues.RequiresHitProxies(false)
+				.ShouldSimulatePhysics(false)
+				.EnableTraceCollision(false)
+				.CreateNavigation(false)
+				.CreateAISystem(false)
+				.AllowAudioPlayback(false)
+				.CreatePhysicsScene(true);
+			World->InitWorld(InitValues);
+			World->PersistentLevel->UpdateModelComponents();
+			World->UpdateWorldComponents(true, false);
+		}
+		return World;
+	}
+
+	static void UnloadWorld(UWorld* World)
+	{
+		World->DestroyWorld(false);
+		World->RemoveFromRoot();
+		CollectGarbage(RF_NoFlags);
+	}
+
+	/** Calls Func for every actor of World, world partition actors are loaded in batches and released again. */
+	static void ForEachActor(UWorld* World, TFunctionRef<void(AActor*)> Func)
+	{
+		if (UWorldPartition* WorldPartition = World->GetWorldPartition())
+		{
+			FWorldPartitionHelpers::ForEachActorWithLoading(WorldPartition, [&Func](const FWorldPartitionActorDescInstance* ActorDescInstance)
+				{
+					if (AActor* Actor = ActorDescInstance->GetActor())
+					{
+						Func(Actor);
+					}
+					return true;
+				});
+			return;
+		}
+
+		for (AActor* Actor : World->PersistentLevel->Actors)
+		{
+			if (Actor)
+			{
+				Func(Actor);
+			}
+		}
+	}
+
+	static int32 RunReport(UWorld* World)
+	{
+		const UPowerlineToolSettings* ToolSettings = GetDefault<UPowerlineToolSettings>();
+		FPowerlineCostReport Report;
+		Report.CellSize = ToolSettings->ReportCellSize;
+		ForEachActor(World, [&Report](AActor* Actor) { FPowerlineCostAnalyzer::AddActor(Actor, Report); });
+
+		const FPowerlineBudget& Budget = ToolSettings->GetBudget(World);
+		FPowerlineCostAnalyzer::LogReport(Report, Budget);
+
+		TArray<FString> Violations;
+		FPowerlineCostAnalyzer::CheckBudget(Report, Budget, Violations);
+		return Violations.IsEmpty() ? 0 : 1;
+	}
+
+	static int32 RunExport(UWorld* World, const FString& Filename, bool bCenterlines, bool bEndpoints)
+	{
+		FPowerlineExportOptions Options;
+		Options.Format = FPowerlineExporter::GetFormatFromFilename(Filename);
+		Options.bCenterlines = bCenterlines;
+		Options.bEndpoints = bEndpoints;
+
+		// Actors are written as they are loaded, world partition releases them again batch by batch
+		FPowerlineExporter Exporter(Filename, Options);
+		if (!Exporter.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Could not create %s"), *Filename);
+			return 1;
+		}
+		ForEachActor(World, [&Exporter](AActor* Actor) { Exporter.AddActor(Actor); });
+		Exporter.AddGraphPoles(GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->GetNetworkGraph(World));
+
+		FPowerlineExportStats Stats;
+		const bool bSuccess = Exporter.Finish(Stats);
+		UE_LOG(LogTemp, Display, TEXT("Exported %d cable actors to %s: %lld vertices, %lld triangles, %lld lines, %lld endpoints, %.1f MB in %.2fs"),
+			Stats.NumActors, *Filename, Stats.NumVertices, Stats.NumTriangles, Stats.NumLines, Stats.NumEndpoints, Stats.NumBytes / (1024.0 * 1024.0), Stats.Seconds);
+		return bSuccess ? 0 : 1;
+	}
+
+	/** Marks actors made by -Generate, a rerun replaces them cell by cell. */
+	static const FName BatchActorTag(TEXT("PowerlineBatch"));
+	static const TCHAR* CellTagPrefix = TEXT("PowerlineCell_");
+
+	static FIntPoint GetCell(const FVector& Location, float CellSize)
+	{
+		return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+	}
+
+	/** Shard owning Cell, the same in every process. */
+	static int32 GetCellShard(const FIntPoint& Cell, int32 ShardCount)
+	{
+		// Hashed rather than striped, so a dense area of the map spreads over every shard
+		return int32(HashCombine(::GetTypeHash(Cell.X), ::GetTypeHash(Cell.Y)) % uint32(ShardCount));
+	}
+
+	static FName GetCellTag(const FIntPoint& Cell)
+	{
+		return FName(*FString::Printf(TEXT("%s%d_%d"), CellTagPrefix, Cell.X, Cell.Y));
+	}
+
+	/** Cell of an actor made by -Generate, false for any other actor. */
+	static bool GetActorCell(const AActor* Actor, FIntPoint& OutCell)
+	{
+		if (!Actor->ActorHasTag(BatchActorTag)) return false;
+
+		for (const FName& Tag : Actor->Tags)
+		{
+			FString CellName = Tag.ToString();
+			FString X, Y;
+			if (CellName.RemoveFromStart(CellTagPrefix) && CellName.Split(TEXT("_"), &X, &Y))
+			{
+				LexFromString(OutCell.X, *X);
+				LexFromString(OutCell.Y, *Y);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** Always loaded actors carrying RouteActorTag, world partition keeps them in the persistent level. */
+	static void GetRoutes(UWorld* World, FName RouteActorTag, TArray<USplineComponent*>& OutRoutes)
+	{
+		for (AActor* Actor : World->PersistentLevel->Actors)
+		{
+			USplineComponent* Route = Actor && Actor->ActorHasTag(RouteActorTag) ? Actor->FindComponentByClass<USplineComponent>() : nullptr;
+			if (Route)
+			{
+				OutRoutes.Add(Route);
+			}
+		}
+	}
+
+	/**
+	 * What one shard owns of a route: a span belongs to the shard of its midpoint's cell and a pole to the shard of its own cell.
+	 * Ownership is decided on the unsnapped poles, which every process places alike.
+	 */
+	struct FRouteShare
+	{
+		USplineComponent* Route = nullptr;
+		TArray<FIntPoint> PoleCells;
+		TArray<FIntPoint> SpanCells;
+		TBitArray<> OwnedPoles;
+		TBitArray<> OwnedSpans;
+
+		/** Around every owned pole and span end, invalid when the shard owns nothing of the route. */
+		FBox Region = FBox(ForceInit);
+	};
+
+	static void GetRouteShare(USplineComponent* Route, int32 Shard, int32 ShardCount, FRouteShare& OutShare)
+	{
+		const UPowerlineToolSettings* ToolSettings = GetDefault<UPowerlineToolSettings>();
+		FPowerlinePolePlacementSettings FlatPlacement = ToolSettings->BatchPlacement;
+		FlatPlacement.bSnapToTerrain = false;
+		TArray<FTransform> FlatPoles;
+		GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->PlacePolesAlongSpline(Route, FlatPlacement, FlatPoles);
+
+		const int32 NumSpans = FlatPoles.Num() - 1;
+		OutShare.Route = Route;
+		OutShare.PoleCells.SetNumUninitialized(FlatPoles.Num());
+		OutShare.SpanCells.SetNumUninitialized(NumSpans);
+		OutShare.OwnedPoles.Init(false, FlatPoles.Num());
+		OutShare.OwnedSpans.Init(false, NumSpans);
+		for (int32 Pole = 0; Pole < FlatPoles.Num(); Pole++)
+		{
+			const FVector Location = FlatPoles[Pole].GetLocation();
+			OutShare.PoleCells[Pole] = GetCell(Location, ToolSettings->ShardCellSize);
+			if (GetCellShard(OutShare.PoleCells[Pole], ShardCount) == Shard)
+			{
+				OutShare.OwnedPoles[Pole] = true;
+				OutShare.Region += Location;
+			}
+			if (Pole < NumSpans)
+			{
+				const FVector NextLocation = FlatPoles[Pole + 1].GetLocation();
+				OutShare.SpanCells[Pole] = GetCell((Location + NextLocation) * 0.5, ToolSettings->ShardCellSize);
+				if (GetCellShard(OutShare.SpanCells[Pole], ShardCount) == Shard)
+				{
+					OutShare.OwnedSpans[Pole] = true;
+					OutShare.Region += Location;
+					OutShare.Region += NextLocation;
+				}
+			}
+		}
+		if (OutShare.Region.IsValid)
+		{
+			OutShare.Region = OutShare.Region.ExpandBy(FVector(1000.f, 1000.f, ToolSettings->BatchPlacement.TraceDistance));
+		}
+	}
+
+	/** Loads Region of a world partition map until destroyed, does nothing for other maps. */
+	struct FScopedRegionLoad
+	{
+		FScopedRegionLoad(UWorld* World, const FBox& Region)
+		{
+			if (World->GetWorldPartition())
+			{
+				Loader = MakeUnique<FLoaderAdapterShape>(World, Region, TEXT("Powerline Shard"));
+				Loader->Load();
+			}
+		}
+
+		~FScopedRegionLoad()
+		{
+			if (Loader)
+			{
+				Loader->Unload();
+			}
+		}
+
+		TUniquePtr<FLoaderAdapterShape> Loader;
+	};
+
+	/** Destroys the actors an earlier -Generate made in cells Shard owns now and saves their deletion. */
+	static bool DeletePreviousRun(UWorld* World, const FRouteShare& Share, int32 Shard, int32 ShardCount, int32& OutNumDeleted)
+	{
+		FScopedRegionLoad RegionLoad(World, Share.Region);
+
+		TArray<AActor*> PreviousActors;
+		for (AActor* Actor : World->PersistentLevel->Actors)
+		{
+			FIntPoint Cell;
+			if (Actor && GetActorCell(Actor, Cell) && GetCellShard(Cell, ShardCount) == Shard)
+			{
+				PreviousActors.Add(Actor);
+			}
+		}
+
+		// A deleted external actor is saved as the removal of its package
+		TArray<UPackage*> Packages;
+		for (AActor* Actor : PreviousActors)
+		{
+			UPackage* Package = Actor->GetExternalPackage();
+			World->EditorDestroyActor(Actor, true);
+			if (Package)
+			{
+				Packages.Add(Package);
+			}
+		}
+		OutNumDeleted += PreviousActors.Num();
+		return Packages.IsEmpty() || UEditorLoadingAndSavingUtils::SavePackages(Packages, false);
+	}
+
+	/**
+	 * Places the poles of a route and generates what Share owns of it. Poles and spans are split by cell, so every
+	 * actor is tagged with the one cell it belongs to and a later run can replace it.
+	 */
+	static bool GenerateRoute(UWorld* World, const FRouteShare& Share, TArray<AActor*>& OutActors)
+	{
+		const UPowerlineToolSettings* ToolSettings = GetDefault<UPowerlineToolSettings>();
+		const FPowerlinePolePlacementSettings& Placement = ToolSettings->BatchPlacement;
+		const FPowerlineGenerationSettings& Settings = ToolSettings->BatchGeneration;
+		UPowerlineGenerationSubsystem* Subsystem = GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>();
+
+		// Only the terrain under this shard's poles has to be loaded for the snapping traces. They pass through batch actors,
+		// which differ between the shards that snap the same boundary pole, so both shards place it at the same height
+		FScopedRegionLoad RegionLoad(World, Share.Region);
+		TArray<FTransform> Poles;
+		Subsystem->PlacePolesAlongSpline(Share.Route, Placement, Poles, BatchActorTag);
+
+		auto AddActor = [&OutActors](AActor* Actor, const FIntPoint& Cell)
+			{
+				Actor->Tags.Add(BatchActorTag);
+				Actor->Tags.Add(GetCellTag(Cell));
+				OutActors.Add(Actor);
+			};
+
+		TMap<FIntPoint, TArray<FTransform>> CellPoles;
+		for (int32 Pole = 0; Pole < Poles.Num(); Pole++)
+		{
+			if (Share.OwnedPoles[Pole])
+			{
+				CellPoles.FindOrAdd(Share.PoleCells[Pole]).Add(Poles[Pole]);
+			}
+		}
+		for (const TPair<FIntPoint, TArray<FTransform>>& Pair : CellPoles)
+		{
+			UHierarchicalInstancedStaticMeshComponent* PoleInstances = Subsystem->SpawnPoleInstances(World, Pair.Value, Placement.PoleMesh);
+			if (!PoleInstances) return false;
+			AddActor(PoleInstances->GetOwner(), Pair.Key);
+		}
+
+		// Every run of consecutive owned spans in one cell is one generation, its end poles may belong to a neighbour
+		const int32 NumSpans = Share.OwnedSpans.Num();
+		for (int32 FirstSpan = 0; FirstSpan < NumSpans; FirstSpan++)
+		{
+			if (!Share.OwnedSpans[FirstSpan]) continue;
+
+			int32 LastSpan = FirstSpan;
+			while (LastSpan + 1 < NumSpans && Share.OwnedSpans[LastSpan + 1] && Share.SpanCells[LastSpan + 1] == Share.SpanCells[FirstSpan])
+			{
+				LastSpan++;
+			}
+
+			FMemMark Mark(FMemStack::Get());
+			FPowerlineScratchLocations PoleLocations;
+			FPowerlineScratchLocations SocketLocations;
+			int32 NumSocketsPerPole = 0;
+			Subsystem->ResolvePoleTransforms(MakeArrayView(Poles).Slice(FirstSpan, LastSpan - FirstSpan + 2), Placement.PoleMesh, Settings, PoleLocations, SocketLocations, NumSocketsPerPole);
+
+			FPowerlineGenerationResult Result;
+			Subsystem->GeneratePowerlines(World, PoleLocations, SocketLocations, NumSocketsPerPole, Settings, Result);
+			for (AActor* Actor : Result.CreatedActors)
+			{
+				AddActor(Actor, Share.SpanCells[FirstSpan]);
+			}
+			if (!Result.bSuccess) return false;
+
+			FirstSpan = LastSpan;
+		}
+		return true;
+	}
+
+	static int32 RunGenerate(UWorld* World, int32 Shard, int32 ShardCount, const FString& RunId)
+	{
+		const UPowerlineToolSettings* ToolSettings = GetDefault<UPowerlineToolSettings>();
+		if (!ToolSettings->BatchPlacement.PoleMesh)
+		{
+			UE_LOG(LogTemp, Error, TEXT("-Generate needs a pole mesh in the batch placement settings"));
+			return 1;
+		}
+
+		// Shards can only save side by side when every actor has a package of its own
+		const bool bExternalActors = World->PersistentLevel->IsUsingExternalActors();
+		if (ShardCount > 1 && !bExternalActors)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s does not use external actors, it can only be generated by a single process"), *World->GetName());
+			return 1;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		TArray<USplineComponent*> Routes;
+		GetRoutes(World, ToolSettings->RouteActorTag, Routes);
+		TArray<FRouteShare> Shares;
+		Shares.SetNum(Routes.Num());
+		for (int32 Route = 0; Route < Routes.Num(); Route++)
+		{
+			GetRouteShare(Routes[Route], Shard, ShardCount, Shares[Route]);
+		}
+		Shares.RemoveAll([](const FRouteShare& Share) { return !Share.Region.IsValid; });
+
+		// Everything of the previous run goes first, a cell crossed by two routes would otherwise lose the first one's new cables
+		int32 Result = 0;
+		int32 NumDeleted = 0;
+		for (const FRouteShare& Share : Shares)
+		{
+			if (!DeletePreviousRun(World, Share, Shard, ShardCount, NumDeleted))
+			{
+				Result = 1;
+			}
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		// A shard only sees its own regions, the level budget is checked by a -Report run over the whole map instead
+		UPowerlineGenerationSubsystem* Subsystem = GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>();
+		Subsystem->SetShardActorPrefix(ShardCount > 1 ? FString::Printf(TEXT("Powerline_%s_%d"), *RunId, Shard) : FString());
+		Subsystem->SetBudgetCheckEnabled(false);
+
+		int32 NumActors = 0;
+		for (const FRouteShare& Share : Shares)
+		{
+			TArray<AActor*> Actors;
+			if (!GenerateRoute(World, Share, Actors))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Could not generate along %s"), *Share.Route->GetOwner()->GetActorNameOrLabel());
+				Result = 1;
+			}
+			NumActors += Actors.Num();
+
+			// Saved route by route, so the region loaded for a route can go before the next one
+			TArray<UPackage*> Packages;
+			for (AActor* Actor : Actors)
+			{
+				if (UPackage* Package = Actor->GetExternalPackage())
+				{
+					Packages.Add(Package);
+				}
+			}
+			if (!Packages.IsEmpty() && !UEditorLoadingAndSavingUtils::SavePackages(Packages, false))
+			{
+				Result = 1;
+			}
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+		Subsystem->SetShardActorPrefix(FString());
+		Subsystem->SetBudgetCheckEnabled(true);
+
+		// A single process also owns the network graph and, without external actors, the map itself
+		TArray<UPackage*> Packages;
+		if (ShardCount == 1)
+		{
+			if (UPowerlineNetworkGraph* Graph = Subsystem->GetNetworkGraph(World))
+			{
+				Packages.Add(Graph->GetPackage());
+			}
+		}
+		if (!bExternalActors && NumActors + NumDeleted > 0)
+		{
+			Packages.Add(World->GetPackage());
+		}
+		if (!Packages.IsEmpty() && !UEditorLoadingAndSavingUtils::SavePackages(Packages, true))
+		{
+			Result = 1;
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("Shard %d of %d replaced %d actors with %d along %d routes in %.1fs"),
+			Shard + 1, ShardCount, NumDeleted, NumActors, Shares.Num(), FPlatformTime::Seconds() - StartTime);
+		return Result;
+	}
+
+	/** Runs -Generate in NumWorkers copies of this process, one shard each, and fails when any of them does. */
+	static int32 RunWorkers(const FString& MapName, int32 NumWorkers)
+	{
+		const FString RunId = FGuid::NewGuid().ToString(EGuidFormats::Base36Encoded);
+		const FString ProjectFile = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+		const double StartTime = FPlatformTime::Seconds();
+
+		TArray<FProcHandle> Workers;
+		for (int32 Shard = 0; Shard < NumWorkers; Shard++)
+		{
+			const FString Args = FString::Printf(TEXT("\"%s\" -run=PowerlineTool -Map=%s -Generate -Shard=%d -ShardCount=%d -RunId=%s -unattended -nopause -nosplash"),
+				*ProjectFile, *MapName, Shard, NumWorkers, *RunId);
+			Workers.Add(FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Args, false, true, true, nullptr, 0, nullptr, nullptr));
+		}
+
+		int32 Result = 0;
+		for (int32 Shard = 0; Shard < NumWorkers; Shard++)
+		{
+			FProcHandle& Worker = Workers[Shard];
+			int32 ReturnCode = 1;
+			if (Worker.IsValid())
+			{
+				FPlatformProcess::WaitForProc(Worker);
+				FPlatformProcess::GetProcReturnCode(Worker, &ReturnCode);
+				FPlatformProcess::CloseProc(Worker);
+			}
+			if (ReturnCode != 0)
+			{
+				UE_LOG(LogTemp, Error, TEXT("Shard %d of %d failed with %d"), Shard + 1, NumWorkers, ReturnCode);
+				Result = 1;
+			}
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("%d workers generated %s in %.1fs"), NumWorkers, *MapName, FPlatformTime::Seconds() - StartTime);
+		return Result;
+	}
+}
+
+UPowerlineToolCommandlet::UPowerlineToolCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UPowerlineToolCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	const FString* MapName = ParamValues.Find(TEXT("Map"));
+	if (!MapName)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PowerlineTool commandlet needs -Map=/Game/Path/To/Map"));
+		return 1;
+	}
+
+	// The coordinator only starts the workers, it never loads the map itself
+	if (const FString* NumWorkers = ParamValues.Find(TEXT("Workers")))
+	{
+		return PowerlineToolCommandlet::RunWorkers(*MapName, FMath::Max(FCString::Atoi(**NumWorkers), 1));
+	}
+
+	UWorld* World = PowerlineToolCommandlet::LoadWorld(*MapName);
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not load map %s"), **MapName);
+		return 1;
+	}
+
+	int32 Result = 0;
+	if (Switches.Contains(TEXT("Generate")))
+	{
+		const int32 ShardCount = FMath::Max(FCString::Atoi(*ParamValues.FindRef(TEXT("ShardCount"))), 1);
+		const int32 Shard = FMath::Clamp(FCString::Atoi(*ParamValues.FindRef(TEXT("Shard"))), 0, ShardCount - 1);
+		FString RunId = ParamValues.FindRef(TEXT("RunId"));
+		if (RunId.IsEmpty())
+		{
+			RunId = FGuid::NewGuid().ToString(EGuidFormats::Base36Encoded);
+		}
+		Result |= PowerlineToolCommandlet::RunGenerate(World, Shard, ShardCount, RunId);
+	}
+	if (Switches.Contains(TEXT("Report")))
+	{
+		Result |= PowerlineToolCommandlet::RunReport(World);
+	}
+	if (const FString* ExportFilename = ParamValues.Find(TEXT("Export")))
+	{
+		Result |= PowerlineToolCommandlet::RunExport(World, *ExportFilename, Switches.Contains(TEXT("Centerlines")), !Switches.Contains(TEXT("NoEndpoints")));
+	}
+
+	PowerlineToolCommandlet::UnloadWorld(World);
+	return Result;
+}
@@ -0,0 +1,46 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineToolLibrary.h"
+#include "PowerlineGenerationSubsystem.h"
+#include "Editor.h"
+
+FPowerlineGenerationResult UPowerlineToolLibrary::GeneratePowerlinesForActors(const TArray<AActor*>& Poles, const FPowerlineGenerationSettings& Settings)
+{
+	return GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->GenerateForActors(Poles, Settings);
+}
+
+FPowerlineGenerationResult UPowerlineToolLibrary::GeneratePowerlinesForTransforms(const TArray<FTransform>& PoleTransforms, UStaticMesh* PoleMesh, const FPowerlineGenerationSettings& Settings)
+{
+	return GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->GenerateForTransforms(PoleTransforms, PoleMesh, Settings);
+}
+
+FPowerlineGenerationResult UPowerlineToolLibrary::GeneratePowerlinesForInstances(UInstancedStaticMeshComponent* PoleInstances, const TArray<int32>& InstanceIndices, const FPowerlineGenerationSettings& Settings)
+{
+	return GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->GenerateForInstances(PoleInstances, InstanceIndices, Settings);
+}
+
+FPowerlineGenerationResult UPowerlineToolLibrary::GeneratePowerlinesAlongSpline(USplineComponent* GuideSpline, const FPowerlinePolePlacementSettings& Placement, const FPowerlineGenerationSettings& Settings)
+{
+	return GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->GenerateAlongSpline(GuideSpline, Placement, Settings);
+}
+
+FPowerlineGenerationPlan UPowerlineToolLibrary::PlanPowerlinesForActors(const TArray<AActor*>& Poles, const FPowerlineGenerationSettings& Settings)
+{
+	return GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->PlanForActors(Poles, Settings);
+}
+
+FPowerlineGenerationResult UPowerlineToolLibrary::CommitPowerlinePlan(const FPowerlineGenerationPlan& Plan)
+{
+	return GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->CommitPlan(Plan);
+}
+
+int32 UPowerlineToolLibrary::ApplyPowerlineSettings(const TArray<AActor*>& CableActors, const FPowerlineGenerationSettings& Settings)
+{
+	return GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->ApplyParameters(CableActors, Settings);
+}
+
+int32 UPowerlineToolLibrary::RetargetCableMesh(const UObject* WorldContextObject, UStaticMesh* OldMesh, UStaticMesh* NewMesh, FVector2D Scale)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->RetargetCableMesh(World, OldMesh, NewMesh, Scale);
+}
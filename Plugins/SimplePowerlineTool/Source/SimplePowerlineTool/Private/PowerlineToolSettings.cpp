@@ -0,0 +1,16 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineToolSettings.h"
+#include "Engine/World.h"
+
+const FPowerlineBudget& UPowerlineToolSettings::GetBudget(const UWorld* World) const
+{
+	if (World)
+	{
+		if (const FPowerlineBudget* LevelBudget = LevelBudgets.Find(TSoftObjectPtr<UWorld>(FSoftObjectPath(World))))
+		{
+			return *LevelBudget;
+		}
+	}
+	return DefaultBudget;
+}
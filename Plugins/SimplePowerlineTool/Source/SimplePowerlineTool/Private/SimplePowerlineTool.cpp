@@ -9,14 +9,21 @@
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SSlider.h"
+#include "Widgets/Input/SSpinBox.h"
 #include "ToolMenus.h"
 
-#include "Engine/Selection.h"
-#include "Engine/StaticMeshSocket.h"
-#include "Components/SplineComponent.h"
-#include "Components/SplineMeshComponent.h"
 #include "ContentBrowserModule.h"
 #include "IContentBrowserSingleton.h"
+#include "PowerlineIntersectionChecker.h"
+#include "PowerlineCookStripper.h"
+#include "PowerlineCompactCableComponent.h"
+#include "PowerlineCostReport.h"
+#include "PowerlineGenerationSubsystem.h"
+#include "PowerlineStreamingComponent.h"
+#include "PowerlineToolSettings.h"
+#include "Editor.h"
+#include "Engine/Selection.h"
+#include "Components/SplineMeshComponent.h"
 
 static const FName SimplePowerlineToolTabName("SimplePowerlineTool");
 
@@ -43,6 +50,8 @@ void FSimplePowerlineToolModule::StartupModule()
 	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(SimplePowerlineToolTabName, FOnSpawnTab::CreateRaw(this, &FSimplePowerlineToolModule::OnSpawnPluginTab))
 		.SetDisplayName(LOCTEXT("FSimplePowerlineToolTabTitle", "SimplePowerlineTool"))
 		.SetMenuType(ETabSpawnerMenuType::Hidden);
+
+	CookStripper = MakeShared<FPowerlineCookStripper>();
 }
 
 void FSimplePowerlineToolModule::ShutdownModule()
@@ -50,6 +59,12 @@ void FSimplePowerlineToolModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 
+	if (CookStripper)
+	{
+		CookStripper->LogReport();
+		CookStripper.Reset();
+	}
+
 	UToolMenus::UnRegisterStartupCallback(this);
 
 	UToolMenus::UnregisterOwner(this);
@@ -106,6 +121,15 @@ TSharedRef<SDockTab> FSimplePowerlineToolModule::OnSpawnPluginTab(const FSpawnTa
 						AssetPicker
 					]
 
+					+ SVerticalBox::Slot()
+					.FillHeight(.1f)
+					[
+						SNew(SButton)
+						.Text(FText::FromString(TEXT("Plan Generation")))
+						.HAlign(HAlign_Center)
+						.VAlign(VAlign_Center)
+						.OnClicked_Raw(this, &FSimplePowerlineToolModule::PlanClicked)
+					]
 					+ SVerticalBox::Slot()
 					.FillHeight(.1f)
 					[
@@ -125,6 +149,50 @@ TSharedRef<SDockTab> FSimplePowerlineToolModule::OnSpawnPluginTab(const FSpawnTa
 						.OnClicked_Raw(this, &FSimplePowerlineToolModule::RegenerateMeshClicked)
 					]
 					+ SVerticalBox::Slot()
+					.FillHeight(.1f)
+					[
+						SNew(SButton)
+						.Text(FText::FromString(TEXT("Apply Settings To Selected Cables")))
+						.HAlign(HAlign_Center)
+						.VAlign(VAlign_Center)
+						.OnClicked_Raw(this, &FSimplePowerlineToolModule::ApplySettingsClicked)
+					]
+					+ SVerticalBox::Slot()
+					.FillHeight(.1f)
+					[
+						SNew(SButton)
+						.Text(FText::FromString(TEXT("Swap Cable Mesh In Level")))
+						.HAlign(HAlign_Center)
+						.VAlign(VAlign_Center)
+						.OnClicked_Raw(this, &FSimplePowerlineToolModule::SwapMeshClicked)
+					]
+					+ SVerticalBox::Slot()
+					.FillHeight(.1f)
+					[
+						SNew(SButton)
+						.Text(FText::FromString(TEXT("Check Cable Intersections")))
+						.HAlign(HAlign_Center)
+						.VAlign(VAlign_Center)
+						.OnClicked_Raw(this, &FSimplePowerlineToolModule::CheckIntersectionsClicked)
+					]
+					+ SVerticalBox::Slot()
+					.FillHeight(.1f)
+					[
+						SNew(SButton)
+						.Text(FText::FromString(TEXT("Cable Cost Report")))
+						.HAlign(HAlign_Center)
+						.VAlign(VAlign_Center)
+						.OnClicked_Raw(this, &FSimplePowerlineToolModule::CostReportClicked)
+					]
+					+ SVerticalBox::Slot()
+					.FillHeight(.05f)
+					[
+						SNew(STextBlock)
+						.Text_Lambda([this]() { return CostSummary; })
+						.AutoWrapText(true)
+						.Justification(ETextJustify::Center)
+					]
+					+ SVerticalBox::Slot()
 					.FillHeight(.05f)
 					[
 						SNew(STextBlock)
@@ -166,6 +234,28 @@ TSharedRef<SDockTab> FSimplePowerlineToolModule::OnSpawnPluginTab(const FSpawnTa
 						.Value(LineBend)
 						.OnValueChanged_Raw(this, &FSimplePowerlineToolModule::OnSliderValueChanged)
 					]
+					+ SVerticalBox::Slot()
+					.FillHeight(.05f)
+					[
+						SNew(SHorizontalBox)
+						+ SHorizontalBox::Slot()
+						.FillWidth(.5f)
+						[
+							SNew(STextBlock)
+							.Text(FText::FromString(TEXT("Spline Segments:")))
+							.Justification(ETextJustify::Center)
+						]
+						+ SHorizontalBox::Slot()
+						.FillWidth(.5f)
+						[
+							// Generate and Apply Settings both use it, so it is shown rather than fixed
+							SNew(SSpinBox<int32>)
+							.MinValue(1)
+							.MaxValue(64)
+							.Value_Lambda([this]() { return SplineSegments; })
+							.OnValueChanged_Raw(this, &FSimplePowerlineToolModule::OnSplineSegmentsChanged)
+						]
+					]
 			]
 		];
 }
@@ -204,299 +294,167 @@ void FSimplePowerlineToolModule::RegisterMenus()
 FReply FSimplePowerlineToolModule::CreateMeshClicked()
 {
 	if (!SelectedMesh) return FReply::Handled();
-	if (!GetSelectedActors()) return FReply::Handled();
-
-	bAttachToSocket = CanOperateOnSockets();
-	if (ActorLocation.IsEmpty()) return FReply::Handled();
-	SpawnPowerlineActors();
 
-	ActorSelection.Empty();
-	ActorLocation.Empty();
+	UPowerlineGenerationSubsystem* GenerationSubsystem = GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>();
+	if (Plan.bValid && IsPlanForSelection())
+	{
+		// Poles moved since planning, the new estimate is shown first and the next click commits it
+		if (!GenerationSubsystem->IsPlanCurrent(Plan))
+		{
+			PlanClicked();
+			CostSummary = FText::FromString(TEXT("Poles moved since planning, check the new plan and generate again\n") + CostSummary.ToString());
+			return FReply::Handled();
+		}
+		GenerationSubsystem->CommitPlan(Plan);
+	}
+	else
+	{
+		GenerationSubsystem->GenerateForSelection(GetToolSettings());
+	}
+	Plan = FPowerlineGenerationPlan();
 	return FReply::Handled();
 }
 
 FReply FSimplePowerlineToolModule::RegenerateMeshClicked()
 {
-	RegenerateMesh();
-
+	GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->RegenerateSelection();
 	return FReply::Handled();
 }
 
-void FSimplePowerlineToolModule::RegenerateMesh()
+FReply FSimplePowerlineToolModule::ApplySettingsClicked()
 {
-	USelection* SelectedActors = GEditor->GetSelectedActors();
-	SelectedActors->GetSelectedObjects<AActor>(ActorSelection);
-
-	if (ActorSelection.Num() > 0)
-	{
-		for (AActor* Object : ActorSelection)
-		{
-			if (Object)
-			{
-				TSet<UActorComponent*> Components = Object->GetComponents();
-				USplineComponent* SplineComponents = nullptr;
-				bool bChanging = false;
-				int32 HowManyChanges = 0;
-				for (UActorComponent* ActorComponent : Components)
-				{
-					if (USplineComponent* SplineComp = Cast<USplineComponent>(ActorComponent))
-					{
-						SplineComponents = SplineComp;
-						bChanging = true;
-						HowManyChanges = 0;
-						continue;
-					}
-					if (bChanging)
-					{
-						if (HowManyChanges < SplineSegments)
-						{
-							if (USplineMeshComponent* MeshComp = Cast<USplineMeshComponent>(ActorComponent))
-							{
-								FVector StartLocation, StartTangent, EndLocation, EndTangent;
-								SplineComponents->GetLocationAndTangentAtSplinePoint(HowManyChanges, StartLocation, StartTangent, ESplineCoordinateSpace::Local);
-								SplineComponents->GetLocationAndTangentAtSplinePoint(HowManyChanges + 1, EndLocation, EndTangent, ESplineCoordinateSpace::Local);
-
-								MeshComp->SetStartAndEnd(StartLocation, StartTangent, EndLocation, EndTangent);
-								HowManyChanges++;
-							}
-						}
-						else
-						{
-							bChanging = false;
-						}
-					}
-				}
-			}
-		}
-	}
+	GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->ApplyParametersToSelection(GetToolSettings());
+	return FReply::Handled();
 }
 
-void FSimplePowerlineToolModule::SpawnPowerlineActors()
+FReply FSimplePowerlineToolModule::SwapMeshClicked()
 {
-	UWorld* World = GEditor->GetEditorWorldContext().World();
-	for (int32 ActorNum = 0; ActorNum < ActorSelection.Num() - 1; ActorNum++)
+	TArray<AActor*> ActorSelection;
+	GEditor->GetSelectedActors()->GetSelectedObjects<AActor>(ActorSelection);
+	if (!SelectedMesh || ActorSelection.IsEmpty()) return FReply::Handled();
+
+	// The first selected cable tells which mesh to replace, every cable using it follows
+	UStaticMesh* OldMesh = nullptr;
+	TInlineComponentArray<USplineMeshComponent*> Segments(ActorSelection[0]);
+	if (!Segments.IsEmpty())
 	{
-		FActorSpawnParameters SpawnParameters;
-		AActor* CableActor = World->SpawnActor<AActor>(AActor::StaticClass(), FVector(0.f, 0.f, 0.f), FRotator(0.f, 0.f, 0.f), SpawnParameters);
-		CreateRootComponent(CableActor);
-		CableActor->SetActorLocation(ActorSelection[ActorNum]->GetActorLocation());
-		CableActor->SetIsSpatiallyLoaded(true);
-
-		for (int32 Index = 0; Index < NumSocketPerActor; Index++)
-		{
-			USplineComponent* SplineComp = CreateSplineComponents(CableActor);
-			AddSplinePoints(SplineComp);
-			SetSplinePointsLocation(SplineComp, ActorNum * NumSocketPerActor + Index);
-			CreateSplineMeshComponents(SplineComp, CableActor);
-		}
+		OldMesh = Segments[0]->GetStaticMesh();
 	}
-}
-
-void FSimplePowerlineToolModule::SetSplinePointsLocation(USplineComponent* SplineComp, int32 Index)
-{
-	FVector DistanceVector = ActorLocation[Index] - ActorLocation[Index + NumSocketPerActor];
-	FVector PointDistance = DistanceVector / SplineSegments;
-
-	FVector StartLocation = ActorLocation[Index + NumSocketPerActor] - PointDistance;
-	FVector BaseStartLocation = StartLocation;
-	for (int32 SplinePoint = 0; SplinePoint < SplineSegments + 1; SplinePoint++)
+	else if (const UPowerlineCompactCableComponent* CompactComp = ActorSelection[0]->FindComponentByClass<UPowerlineCompactCableComponent>())
 	{
-		FVector NewLocation = LineBendZCalculator(SplinePoint, SplineComp, StartLocation);
-		SplineComp->SetLocationAtSplinePoint(SplinePoint, NewLocation + PointDistance, ESplineCoordinateSpace::World);
-		StartLocation += PointDistance;
+		OldMesh = CompactComp->CableMesh;
 	}
+	else if (const UPowerlineStreamingComponent* StreamingComp = ActorSelection[0]->FindComponentByClass<UPowerlineStreamingComponent>())
+	{
+		OldMesh = StreamingComp->CableMesh;
+	}
+	if (!OldMesh) return FReply::Handled();
+
+	GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->RetargetCableMesh(ActorSelection[0]->GetWorld(), OldMesh, SelectedMesh, FVector2D::ZeroVector);
+	return FReply::Handled();
 }
 
-FVector FSimplePowerlineToolModule::LineBendZCalculator(int32 Index, USplineComponent* SplineComp, FVector Location)
+FReply FSimplePowerlineToolModule::CheckIntersectionsClicked()
 {
+	FPowerlineIntersectionReport Report;
+	FPowerlineIntersectionChecker::CheckWorld(GEditor->GetEditorWorldContext().World(), IntersectionTolerance, AttachmentClearance, Report);
+	FPowerlineIntersectionChecker::LogReport(Report, IntersectionTolerance);
 
-	bool bZeroValue = LineBend < 0.f;
-	bool bFirstOrLastIndex = Index == 0 || Index == SplineSegments;
-	if (bZeroValue || bFirstOrLastIndex) return Location;
-
-	int32 NumOfPoints = SplineSegments + 1;
-	int32 HalfOfPoints = (NumOfPoints - 2) / 2; // -2 because without first and last point
-	if (NumOfPoints <= 3) HalfOfPoints = 1;
-	float OneLineBend = LineBend / HalfOfPoints;
-
-	FVector OutVector = Location;
-	if (NumOfPoints % 2 != 0)
-	{
-		if (Index <= HalfOfPoints)
-		{
-			float ZValue = -OneLineBend * Index;
-			OutVector.Z += ZValue;
-			return OutVector;
-		}
-		else
-		{
-			float ZValue = -OneLineBend * (NumOfPoints - Index - 1);
-			OutVector.Z += ZValue;
-			return OutVector;
-		}
-	}
-	else
+	// Select offending cables so they can be found in the outliner
+	if (Report.CableIntersections.Num() > 0 || Report.GeometryIntersections.Num() > 0)
 	{
-		if (Index <= HalfOfPoints)
-		{
-			float ZValue = -OneLineBend * Index;
-			OutVector.Z += ZValue;
-			return OutVector;
-		}
-		else
+		GEditor->SelectNone(false, true);
+		for (const TArray<FPowerlineIntersection>* Intersections : { &Report.CableIntersections, &Report.GeometryIntersections })
 		{
-			float ZValue = -OneLineBend * (NumOfPoints - Index - 1);
-			OutVector.Z += ZValue;
-			return OutVector;
+			for (const FPowerlineIntersection& Intersection : *Intersections)
+			{
+				if (AActor* CableActor = Intersection.CableActor.Get())
+				{
+					GEditor->SelectActor(CableActor, true, false);
+				}
+			}
 		}
+		GEditor->NoteSelectionChange();
 	}
-}
 
-void FSimplePowerlineToolModule::AddSplinePoints(USplineComponent* SplineComp)
-{
-	for (int32 Segment = 0; Segment < SplineSegments - 1; Segment++)
-	{
-		FVector PointPosition;
-		SplineComp->AddSplinePoint(PointPosition, ESplineCoordinateSpace::Local);
-	}
+	return FReply::Handled();
 }
 
-USplineComponent* FSimplePowerlineToolModule::CreateSplineComponents(AActor* CableActor)
+FReply FSimplePowerlineToolModule::CostReportClicked()
 {
-	USplineComponent* SplineComp = NewObject<USplineComponent>(CableActor);
-	if (SplineComp)
-	{
-		SplineComp->SetupAttachment(CableActor->GetRootComponent());
-		SplineComp->RegisterComponent();
-		SplineComp->SetDrawDebug(false);
-		CableActor->AddInstanceComponent(SplineComp);
-		return SplineComp;
-	}
-	else
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Creating USplineComponent FAILED!"));
-	}
-	return nullptr;
-}
+	UWorld* World = GEditor->GetEditorWorldContext().World();
+	const UPowerlineToolSettings* ToolSettings = GetDefault<UPowerlineToolSettings>();
 
-void FSimplePowerlineToolModule::CreateRootComponent(AActor* CableActor)
-{
-	if (!CableActor->GetRootComponent())
+	FPowerlineCostReport Report;
+	FPowerlineCostAnalyzer::GatherWorld(World, ToolSettings->ReportCellSize, Report);
+	FPowerlineCostAnalyzer::LogReport(Report, ToolSettings->GetBudget(World));
+
+	TArray<FString> Violations;
+	FPowerlineCostAnalyzer::CheckBudget(Report, ToolSettings->GetBudget(World), Violations);
+	FString Summary = FPowerlineCostAnalyzer::GetSummary(Report);
+	if (!Violations.IsEmpty())
 	{
-		USceneComponent* RootComp = NewObject<USceneComponent>(CableActor, TEXT("RootComponent"));
-		CableActor->SetRootComponent(RootComp);
-		CableActor->GetRootComponent()->SetMobility(EComponentMobility::Static);
-		RootComp->RegisterComponent();
+		Summary += FString::Printf(TEXT("\nOver budget: %s"), *FString::Join(Violations, TEXT(", ")));
 	}
+	CostSummary = FText::FromString(Summary);
+
+	return FReply::Handled();
 }
 
-bool FSimplePowerlineToolModule::GetSelectedActors()
+FReply FSimplePowerlineToolModule::PlanClicked()
 {
-	USelection* EditorSelection = GEditor->GetSelectedActors();
-	EditorSelection->GetSelectedObjects<AActor>(ActorSelection);
-	if (ActorSelection.Num() > 1)
+	TArray<AActor*> ActorSelection;
+	GEditor->GetSelectedActors()->GetSelectedObjects<AActor>(ActorSelection);
+	Plan = GEditor->GetEditorSubsystem<UPowerlineGenerationSubsystem>()->PlanForActors(ActorSelection, GetToolSettings());
+	PlannedSelection.Reset(ActorSelection.Num());
+	for (AActor* Actor : ActorSelection)
 	{
-		NumSelectedActors = ActorSelection.Num();
-		return true;
+		PlannedSelection.Add(Actor);
 	}
-	else
+
+	if (!Plan.bValid)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Select atleast 2 actors"));
-		return false;
+		CostSummary = FText::FromString(FString::Printf(TEXT("Plan failed: %s"), *Plan.Error));
+		return FReply::Handled();
 	}
-}
 
-bool FSimplePowerlineToolModule::CanOperateOnSockets()
-{
-	UStaticMeshComponent* LastMeshComponent = nullptr;
-	for (AActor* Actor : ActorSelection)
+	FString Summary = FString::Printf(TEXT("Plan: %d spans, %d actors, %d components, %lld triangles, %d draw calls, %.2f MB render, %.2f MB physics, about %.2fs (planned in %.3fs)"),
+		Plan.NumSpans, Plan.PredictedActors, Plan.PredictedComponents, Plan.PredictedTriangles, Plan.PredictedDrawCalls,
+		Plan.PredictedRenderMemoryMB, Plan.PredictedPhysicsMemoryMB, Plan.EstimatedSeconds, Plan.PlanSeconds);
+	if (!Plan.BudgetViolations.IsEmpty())
 	{
-		if (Actor)
-		{
-			if (UStaticMeshComponent* MeshComponent = Actor->GetComponentByClass<UStaticMeshComponent>())
-			{
-				if (LastMeshComponent == nullptr) LastMeshComponent = MeshComponent;
-	
-				bool bNoSockets = MeshComponent->GetAllSocketNames().IsEmpty();
-				bool bSameNumSockets = LastMeshComponent->GetAllSocketNames().Num() == MeshComponent->GetAllSocketNames().Num();
-				if (bNoSockets)
-				{
-					//ActorLocation.Add(MeshComponent->GetComponentLocation());
-					NumSocketPerActor = 1;
-				}
-				else if (LastMeshComponent->GetAllSocketNames().Num() == MeshComponent->GetAllSocketNames().Num())
-				{
-					NumSocketPerActor = MeshComponent->GetAllSocketNames().Num();
-				}
-				else
-				{
-					UE_LOG(LogTemp, Warning, TEXT("One of selected actors have different amount of sockets"));
-					ActorLocation.Empty();
-					return false;
-				}
-				SaveSocketsLocation(MeshComponent);
-				LastMeshComponent = MeshComponent;
-			}
-			else
-			{
-				UE_LOG(LogTemp, Warning, TEXT("One of selected actors, don't have MeshComponent"));
-				return false;
-			}
-		}
+		Summary += FString::Printf(TEXT("\n%s: %s"), Plan.bRefusedByBudget ? TEXT("Refused, over budget") : TEXT("Over budget"), *FString::Join(Plan.BudgetViolations, TEXT(", ")));
 	}
-	return true;
+	CostSummary = FText::FromString(Summary);
+	return FReply::Handled();
 }
 
-void FSimplePowerlineToolModule::SaveSocketsLocation(UStaticMeshComponent* MeshComponent)
+bool FSimplePowerlineToolModule::IsPlanForSelection() const
 {
-	TArray<FName> Names = MeshComponent->GetAllSocketNames();
-	if (Names.IsEmpty())
-	{
-		ActorLocation.Add(MeshComponent->GetComponentLocation());
-	}
-	else
+	TArray<AActor*> ActorSelection;
+	GEditor->GetSelectedActors()->GetSelectedObjects<AActor>(ActorSelection);
+	if (ActorSelection.Num() != PlannedSelection.Num()) return false;
+
+	for (int32 Index = 0; Index < ActorSelection.Num(); Index++)
 	{
-		for (FName Name : Names)
-		{
-			ActorLocation.Add(MeshComponent->GetSocketLocation(Name));
-		}
+		if (PlannedSelection[Index].Get() != ActorSelection[Index]) return false;
 	}
+	return true;
 }
 
-void FSimplePowerlineToolModule::CreateSplineMeshComponents(USplineComponent* SplineComp, AActor* CableActor)
+FPowerlineGenerationSettings FSimplePowerlineToolModule::GetToolSettings() const
 {
-	for (int32 Point = 0; Point <= SplineComp->GetNumberOfSplinePoints() - 2; Point++)
-	{
-		FVector StartLocation, StartTangent, EndLocation, EndTangent;
-		SplineComp->GetLocationAndTangentAtSplinePoint(Point, StartLocation, StartTangent, ESplineCoordinateSpace::Local);
-		SplineComp->GetLocationAndTangentAtSplinePoint(Point + 1, EndLocation, EndTangent, ESplineCoordinateSpace::Local);
-
-		USplineMeshComponent* SplineMeshComp = NewObject<USplineMeshComponent>(CableActor, USplineMeshComponent::StaticClass());
-		if (SplineMeshComp)
-		{
-			SplineMeshComp->AttachToComponent(CableActor->GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
-			SplineMeshComp->RegisterComponent();
-			SplineMeshComp->SetStartAndEnd(StartLocation, StartTangent, EndLocation, EndTangent);
-			CableActor->AddInstanceComponent(SplineMeshComp);
-			if (SelectedMesh)
-			{
-				SplineMeshComp->SetStaticMesh(SelectedMesh);
-			}
-			else
-			{
-				UE_LOG(LogTemp, Warning, TEXT("No CableMesh"));
-			}
-		}
-		else
-		{
-			UE_LOG(LogTemp, Warning, TEXT("SplineMeshComp not valid"));
-		}
-	}
+	FPowerlineGenerationSettings Settings;
+	Settings.CableMesh = SelectedMesh;
+	Settings.SplineSegments = SplineSegments;
+	Settings.LineBend = LineBend;
+	return Settings;
 }
 
 void FSimplePowerlineToolModule::OnAssetSelected(const FAssetData& AssetData)
 {
 	SelectedMesh = Cast<UStaticMesh>(AssetData.GetAsset());
+	Plan = FPowerlineGenerationPlan();
 	if (SelectedMesh)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Asset Selected: %s"), *SelectedMesh->GetName());
@@ -506,6 +464,13 @@ void FSimplePowerlineToolModule::OnAssetSelected(const FAssetData& AssetData)
 void FSimplePowerlineToolModule::OnSliderValueChanged(float Value)
 {
 	LineBend = Value;
+	Plan = FPowerlineGenerationPlan();
+}
+
+void FSimplePowerlineToolModule::OnSplineSegmentsChanged(int32 Value)
+{
+	SplineSegments = Value;
+	Plan = FPowerlineGenerationPlan();
 }
 	
 IMPLEMENT_MODULE(FSimplePowerlineToolModule, SimplePowerlineTool)
\ No newline at end of file
@@ -0,0 +1,251 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "Misc/MemStack.h"
+#include "UObject/ObjectKey.h"
+#include "PowerlineSagTable.h"
+#include "PowerlineToolTypes.h"
+#include "PowerlineGenerationSubsystem.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UInstancedStaticMeshComponent;
+class UPowerlineNetworkGraph;
+class USplineMeshComponent;
+class USplineComponent;
+class UStaticMesh;
+struct FPowerlineCostReport;
+
+/** Temporaries of one generation call live on the frame scoped FMemStack instead of the heap. */
+using FPowerlineScratchLocations = TArray<FVector, TMemStackAllocator<>>;
+
+using FPowerlineScratchPoleRefs = TArray<FPowerlinePoleRef, TMemStackAllocator<>>;
+
+/**
+ * Cable generation engine shared by the plugin tab, the editor utility widget and scripts.
+ * Front-ends only collect input and settings, all spawning and spline math lives here.
+ */
+UCLASS()
+class SIMPLEPOWERLINETOOL_API UPowerlineGenerationSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Connects the sockets of consecutive pole actors. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	FPowerlineGenerationResult GenerateForActors(const TArray<AActor*>& Poles, const FPowerlineGenerationSettings& Settings);
+
+	/** Connects consecutive pole transforms, socket positions come from PoleMesh. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	FPowerlineGenerationResult GenerateForTransforms(const TArray<FTransform>& PoleTransforms, UStaticMesh* PoleMesh, const FPowerlineGenerationSettings& Settings);
+
+	/**
+	 * Connects instances of PoleInstances in the given order, all of them in instance order when InstanceIndices is empty.
+	 * Works for HISM and ISM pole forests, socket positions come from each instance transform and the instanced mesh.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	FPowerlineGenerationResult GenerateForInstances(UInstancedStaticMeshComponent* PoleInstances, const TArray<int32>& InstanceIndices, const FPowerlineGenerationSettings& Settings);
+
+	/**
+	 * Places poles along GuideSpline at Placement's spacing, snapped to the terrain and turned along the route,
+	 * then connects them in the same pass. The poles are instances of a single actor.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	FPowerlineGenerationResult GenerateAlongSpline(USplineComponent* GuideSpline, const FPowerlinePolePlacementSettings& Placement, const FPowerlineGenerationSettings& Settings);
+
+	/** Connects the actors selected in the level editor, in selection order. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	FPowerlineGenerationResult GenerateForSelection(const FPowerlineGenerationSettings& Settings);
+
+	/**
+	 * Resolves and validates Poles and predicts what connecting them costs without touching the world.
+	 * CommitPlan spawns the plan as it is, the poles are not resolved again.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	FPowerlineGenerationPlan PlanForActors(const TArray<AActor*>& Poles, const FPowerlineGenerationSettings& Settings);
+
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	FPowerlineGenerationPlan PlanForSelection(const FPowerlineGenerationSettings& Settings);
+
+	/**
+	 * Spawns the cables of Plan. Nothing is spawned when the plan is invalid, refused by the budget
+	 * or one of its poles was deleted or moved since, see IsPlanCurrent.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	FPowerlineGenerationResult CommitPlan(const FPowerlineGenerationPlan& Plan);
+
+	/** Whether every pole of Plan still exists and sits where it was planned. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	bool IsPlanCurrent(const FPowerlineGenerationPlan& Plan) const;
+
+	/** Updates the spline mesh segments of cable actors to follow their splines again. Returns the number of updated segments. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	int32 RegenerateCables(const TArray<AActor*>& CableActors);
+
+	/** Regenerates the selected cable actors and, through the level's network graph, the cables of the selected poles. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	int32 RegenerateSelection();
+
+	/**
+	 * Applies SplineSegments and the sag of Settings to existing cable actors in place, span ends stay where they are.
+	 * Segment components are reused and only created or destroyed when the segment count changes, the cable math runs in parallel.
+	 * Continuous cables need their spans in the network graph. Returns the number of updated cables.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	int32 ApplyParameters(const TArray<AActor*>& CableActors, const FPowerlineGenerationSettings& Settings);
+
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	int32 ApplyParametersToSelection(const FPowerlineGenerationSettings& Settings);
+
+	/** Cable components of World using CableMesh: generated spline mesh segments, compact and streaming cable components. */
+	void FindCableMeshUsers(UWorld* World, const UStaticMesh* CableMesh, TArray<UActorComponent*>& OutComponents);
+
+	/**
+	 * Switches every cable of World using OldMesh to NewMesh, or keeps OldMesh when NewMesh is null, at the cross section Scale.
+	 * A zero Scale keeps the scale of each cable. Cables are found through an index from mesh to components and updated
+	 * in place, nothing is respawned. Returns the number of updated components.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	int32 RetargetCableMesh(UWorld* World, UStaticMesh* OldMesh, UStaticMesh* NewMesh, FVector2D Scale);
+
+	/** Network graph of World's level, created when bCreate and Project Settings maintain one. Null for unsaved levels. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	UPowerlineNetworkGraph* GetNetworkGraph(UWorld* World, bool bCreate = false) const;
+
+	/**
+	 * Collects the endpoints of every pole, NumSocketsPerPole entries per pole.
+	 * Without bAttachToSockets, or for meshes without sockets, a pole contributes a single endpoint.
+	 * An actor whose mesh component is instanced contributes every instance as a pole.
+	 * Fails when a pole has no mesh or a different socket count. OutPoleRefs, when given, gets one entry per pole location.
+	 */
+	bool ResolvePoleActors(TArrayView<AActor* const> Poles, const FPowerlineGenerationSettings& Settings, FPowerlineScratchLocations& OutPoleLocations, FPowerlineScratchLocations& OutSocketLocations, int32& OutNumSocketsPerPole, FPowerlineScratchPoleRefs* OutPoleRefs = nullptr) const;
+
+	/** Same as ResolvePoleTransforms for instances of PoleInstances, all of them when InstanceIndices is empty. */
+	void ResolvePoleInstances(UInstancedStaticMeshComponent* PoleInstances, TArrayView<const int32> InstanceIndices, const FPowerlineGenerationSettings& Settings, FPowerlineScratchLocations& OutPoleLocations, FPowerlineScratchLocations& OutSocketLocations, int32& OutNumSocketsPerPole, FPowerlineScratchPoleRefs* OutPoleRefs = nullptr) const;
+
+	/**
+	 * Pole transforms along GuideSpline in world space, terrain traces run in parallel.
+	 * Traces pass through actors tagged IgnoredActorTag, so poles and cables generated earlier do not change where a pole lands.
+	 */
+	void PlacePolesAlongSpline(const USplineComponent* GuideSpline, const FPowerlinePolePlacementSettings& Placement, TArray<FTransform>& OutPoleTransforms, FName IgnoredActorTag = NAME_None) const;
+
+	/** Same as ResolvePoleActors for poles that only exist as transforms, socket layout comes from PoleMesh. */
+	void ResolvePoleTransforms(TArrayView<const FTransform> Poles, const UStaticMesh* PoleMesh, const FPowerlineGenerationSettings& Settings, FPowerlineScratchLocations& OutPoleLocations, FPowerlineScratchLocations& OutSocketLocations, int32& OutNumSocketsPerPole) const;
+
+	/**
+	 * Connects matching sockets of consecutive poles, either with one cable actor per pole pair,
+	 * continuous cables spanning many poles or one streaming actor for all of them.
+	 * The spans are recorded in the network graph, poles without PoleRefs are recorded by location only.
+	 */
+	void GeneratePowerlines(UWorld* World, TArrayView<const FVector> PoleLocations, TArrayView<const FVector> SocketLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, FPowerlineGenerationResult& OutResult, TArrayView<const FPowerlinePoleRef> PoleRefs = TArrayView<const FPowerlinePoleRef>());
+
+	/** One actor holding PoleTransforms as instances of PoleMesh. */
+	UHierarchicalInstancedStaticMeshComponent* SpawnPoleInstances(UWorld* World, TArrayView<const FTransform> PoleTransforms, UStaticMesh* PoleMesh);
+
+	/**
+	 * Names every actor spawned from now on Prefix_N and leaves the network graph alone, until called with an empty prefix.
+	 * Lets several processes generate into one world partition map, each writing its own external actor packages.
+	 */
+	void SetShardActorPrefix(const FString& Prefix);
+
+	/** Batch runs turn the per generation level budget check off, they only see part of the level at a time. */
+	void SetBudgetCheckEnabled(bool bEnabled) { bBudgetCheckEnabled = bEnabled; }
+
+	/** Vertical offset of a spline point, the span hangs down in a parabola that is LineBend deep at the middle. */
+	static float GetLineBendOffset(int32 Index, const FPowerlineGenerationSettings& Settings);
+
+	/** Mid span sag between two sockets, LineBend or the conductor profile's sag for this span. */
+	float GetSpanSag(const FVector& SpanStart, const FVector& SpanEnd, const FPowerlineGenerationSettings& Settings);
+
+	/** Malloc and realloc calls made so far, zero when the allocator does not count them (shipping builds). */
+	static uint64 GetNumHeapAllocations();
+
+private:
+	/** Checks the level's cost after the planned generation against UPowerlineToolSettings, false when it must not go ahead. */
+	bool CheckGenerationBudget(UWorld* World, TArrayView<const FVector> PoleLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings);
+	void GetBudgetViolations(UWorld* World, TArrayView<const FVector> PoleLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, TArray<FString>& OutViolations);
+
+	/** Validates the resolved poles of Plan and fills in its predicted cost. */
+	void EstimatePlan(FPowerlineGenerationPlan& Plan);
+
+	/** Gathers the cost report of World again when it was gathered for another world or the level changed outside the tool since. */
+	void UpdateCostReport(UWorld* World);
+	/** Adds the actors of one generation to the cost report, unless the report is gathered again on the next check anyway. */
+	void AddToCostReport(UWorld* World, TArrayView<const TObjectPtr<AActor>> Actors);
+
+	void OnLevelActorAdded(AActor* Actor);
+
+	/** GeneratePowerlines after validation and the budget check. */
+	void ExecuteGeneration(UWorld* World, TArrayView<const FVector> PoleLocations, TArrayView<const FVector> SocketLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, FPowerlineGenerationResult& OutResult, TArrayView<const FPowerlinePoleRef> PoleRefs);
+
+	/** Rebuilds the cable mesh index from the actors of World when it was built for another world or levels were loaded since. */
+	void UpdateCableMeshIndex(UWorld* World);
+	/** Adds the cable components of Actor to the cable mesh index, unless the index is rebuilt on the next lookup anyway. */
+	void IndexCableActor(AActor* Actor);
+	void IndexCableComponent(UActorComponent* Component);
+
+	/** Keeps the level's network graph from pointing at deleted cable actors. */
+	void OnLevelActorDeleted(AActor* Actor);
+
+	void GenerateSpanActors(UWorld* World, TArrayView<const FVector> PoleLocations, TArrayView<const FVector> SocketLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, FPowerlineGenerationResult& OutResult);
+	void GenerateContinuousCables(UWorld* World, TArrayView<const FVector> PoleLocations, TArrayView<const FVector> SocketLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, FPowerlineGenerationResult& OutResult);
+	/** Quantized cables of one pole pair on a single UPowerlineCompactCableComponent of CableActor. */
+	void CreateCompactCables(AActor* CableActor, int32 PoleNum, TArrayView<const FVector> SocketLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, FPowerlineGenerationResult& OutResult);
+	void GenerateStreamingSpans(UWorld* World, TArrayView<const FVector> PoleLocations, TArrayView<const FVector> SocketLocations, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings, FPowerlineGenerationResult& OutResult);
+	FActorSpawnParameters MakeSpawnParameters();
+	void CreateRootComponent(AActor* CableActor) const;
+	USplineComponent* CreateSplineComponent(AActor* CableActor) const;
+	void SetSplinePoints(USplineComponent* SplineComp, const FVector& SpanStart, const FVector& SpanEnd, const FPowerlineGenerationSettings& Settings);
+	/** One spline along socket Track across every span from FirstPole to LastPole. */
+	void SetContinuousSplinePoints(USplineComponent* SplineComp, TArrayView<const FVector> SocketLocations, int32 FirstPole, int32 LastPole, int32 Track, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings);
+	/** Single capsule chain body for every cable of CableActor, built from its spline meshes. */
+	void CreateCollisionComponent(AActor* CableActor) const;
+	int32 CreateSplineMeshComponents(USplineComponent* SplineComp, AActor* CableActor, const FPowerlineGenerationSettings& Settings) const;
+	/** One segment attached to SplineComp, CollisionProfile is applied unless it is none. */
+	USplineMeshComponent* CreateSplineMeshComponent(USplineComponent* SplineComp, AActor* CableActor, UStaticMesh* CableMesh, FName CollisionProfile) const;
+	/** Points.Num() - 1 segments along Points, reusing Segments and creating or destroying the difference. */
+	void ReshapeSplineSegments(AActor* CableActor, USplineComponent* SplineComp, TArray<USplineMeshComponent*, TInlineAllocator<16>>& Segments, TConstArrayView<FVector> Points, TConstArrayView<FVector> Tangents) const;
+
+	/** Adds the poles of one generation call to Settings' or the level's network graph, spans follow through RecordSpan. */
+	void BeginNetworkRecording(UWorld* World, TArrayView<const FVector> PoleLocations, TArrayView<const FPowerlinePoleRef> PoleRefs, int32 NumSocketsPerPole, const FPowerlineGenerationSettings& Settings);
+	/** Span from pole PoleNum + 1 back to PoleNum, the direction every generator builds cables in. */
+	void RecordSpan(int32 PoleNum, int32 Socket, AActor* CableActor, TConstArrayView<UActorComponent*> Components);
+	void EndNetworkRecording();
+
+	/** Built for the last conductor profile used, rebuilding it costs a few thousand catenary solves. */
+	FPowerlineSagTable SagTable;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UPowerlineNetworkGraph> RecordingGraph;
+
+	/** Graph pole index of every pole of the current generation call. */
+	TArray<int32> RecordingPoles;
+
+	FDelegateHandle LevelActorDeletedHandle;
+	FDelegateHandle LevelActorAddedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LoaderAdapterHandle;
+	FDelegateHandle UndoRedoHandle;
+
+	/** Components of CableMeshIndexWorld using each cable mesh, deleted components are dropped on lookup. */
+	TMap<TObjectKey<UStaticMesh>, TSet<TWeakObjectPtr<UActorComponent>>> CableMeshUsers;
+	TWeakObjectPtr<UWorld> CableMeshIndexWorld;
+	bool bCableMeshIndexDirty = true;
+
+	/** Cost of the cables already in CostReportWorld, the budget check adds each generation's estimate to it. */
+	TSharedPtr<FPowerlineCostReport> CostReport;
+	TWeakObjectPtr<UWorld> CostReportWorld;
+	bool bCostReportDirty = true;
+
+	FString ShardActorPrefix;
+	int32 NumShardActors = 0;
+	bool bBudgetCheckEnabled = true;
+
+	/** Measured by the last generation, plans predict their time from it. */
+	double SecondsPerComponent = 0.0001;
+};
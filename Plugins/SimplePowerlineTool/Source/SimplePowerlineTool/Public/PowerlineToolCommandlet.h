@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PowerlineToolCommandlet.generated.h"
+
+/**
+ * Batch access to the powerline tool for build machines.
+ *
+ * UnrealEditor-Cmd.exe Project.uproject -run=PowerlineTool -Map=/Game/Maps/Level -Report
+ *
+ * -Generate  generates along every actor tagged with the route tag of UPowerlineToolSettings and saves the result,
+ *     replacing what an earlier -Generate made. The level budget is not checked per generation, add -Report for it
+ *     -Shard=I -ShardCount=N  only the part of the routes shard I of N owns, see ShardCellSize
+ * -Workers=N  runs -Generate in N processes side by side, for world partition maps too large for one
+ * -Report  logs the cable cost of the map and fails when it is over the budget in UPowerlineToolSettings
+ * -Export=Path/Cables.obj|.gltf  writes the cable geometry and endpoints of the map
+ *     -Centerlines  cable centre lines instead of the deformed cable meshes
+ *     -NoEndpoints  leaves out span ends and poles
+ */
+UCLASS()
+class SIMPLEPOWERLINETOOL_API UPowerlineToolCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPowerlineToolCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
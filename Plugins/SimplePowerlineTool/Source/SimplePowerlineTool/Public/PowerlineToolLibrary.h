@@ -0,0 +1,54 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "PowerlineToolTypes.h"
+#include "PowerlineToolLibrary.generated.h"
+
+class UInstancedStaticMeshComponent;
+class USplineComponent;
+
+/**
+ * Scriptable entry points of the powerline tool, usable from Editor Utility Blueprints and Python.
+ * Cables are generated between consecutive poles of the input array, all spans in one call.
+ */
+UCLASS()
+class SIMPLEPOWERLINETOOL_API UPowerlineToolLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** Connects the sockets of consecutive pole actors. Every pole needs a static mesh with the same number of sockets. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	static FPowerlineGenerationResult GeneratePowerlinesForActors(const TArray<AActor*>& Poles, const FPowerlineGenerationSettings& Settings);
+
+	/** Connects consecutive pole transforms, socket positions come from PoleMesh. Without a PoleMesh the transforms are the endpoints. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	static FPowerlineGenerationResult GeneratePowerlinesForTransforms(const TArray<FTransform>& PoleTransforms, UStaticMesh* PoleMesh, const FPowerlineGenerationSettings& Settings);
+
+	/** Connects instances of a HISM/ISM pole component, all of them in instance order when InstanceIndices is empty. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	static FPowerlineGenerationResult GeneratePowerlinesForInstances(UInstancedStaticMeshComponent* PoleInstances, const TArray<int32>& InstanceIndices, const FPowerlineGenerationSettings& Settings);
+
+	/** Places poles along GuideSpline snapped to the terrain and connects them, the whole line in one call. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	static FPowerlineGenerationResult GeneratePowerlinesAlongSpline(USplineComponent* GuideSpline, const FPowerlinePolePlacementSettings& Placement, const FPowerlineGenerationSettings& Settings);
+
+	/** Validates the poles and predicts actors, components, triangles, memory and time of connecting them, nothing is spawned. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	static FPowerlineGenerationPlan PlanPowerlinesForActors(const TArray<AActor*>& Poles, const FPowerlineGenerationSettings& Settings);
+
+	/** Spawns a plan made by PlanPowerlinesForActors as it is, nothing is spawned once one of its poles moved. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	static FPowerlineGenerationResult CommitPowerlinePlan(const FPowerlineGenerationPlan& Plan);
+
+	/** Reshapes existing cable actors to the segment count and sag of Settings in place, returns the number of updated cables. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool")
+	static int32 ApplyPowerlineSettings(const TArray<AActor*>& CableActors, const FPowerlineGenerationSettings& Settings);
+
+	/** Switches every cable of World using OldMesh to NewMesh and Scale in place, a zero Scale keeps each cable's scale. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline Tool", meta = (WorldContext = "WorldContextObject"))
+	static int32 RetargetCableMesh(const UObject* WorldContextObject, UStaticMesh* OldMesh, UStaticMesh* NewMesh, FVector2D Scale);
+};
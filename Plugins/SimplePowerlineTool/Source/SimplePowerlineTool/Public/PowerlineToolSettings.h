@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "PowerlineToolTypes.h"
+#include "PowerlineToolSettings.generated.h"
+
+/** Limits for the cables of one level, zero means no limit. */
+USTRUCT(BlueprintType)
+struct SIMPLEPOWERLINETOOL_API FPowerlineBudget
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget", meta = (ClampMin = "0"))
+	int32 MaxComponents = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget", meta = (ClampMin = "0"))
+	int32 MaxSplinePoints = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget", meta = (ClampMin = "0.0", Units = "Megabytes"))
+	float MaxRenderMemoryMB = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget", meta = (ClampMin = "0.0", Units = "Megabytes"))
+	float MaxPhysicsMemoryMB = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget", meta = (ClampMin = "0"))
+	int64 MaxTriangles = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget", meta = (ClampMin = "0"))
+	int32 MaxDrawCalls = 0;
+
+	/** Draw calls within one world partition cell, what a player near the line actually pays for. A cable actor counts in the cell of its first pole. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget", meta = (ClampMin = "0"))
+	int32 MaxDrawCallsPerCell = 0;
+};
+
+UENUM()
+enum class EPowerlineBudgetAction : uint8
+{
+	Ignore,
+	/** Generate anyway and log what goes over budget. */
+	Warn,
+	/** Skip a generation that would go over budget. */
+	Refuse,
+};
+
+/** Project settings of the powerline tool, found under Plugins > Powerline Tool. */
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Powerline Tool"))
+class SIMPLEPOWERLINETOOL_API UPowerlineToolSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	/** Budget of World, DefaultBudget when the level has none of its own. */
+	const FPowerlineBudget& GetBudget(const UWorld* World) const;
+
+	/** What generation does when the new cables would exceed the level budget. */
+	UPROPERTY(config, EditAnywhere, Category = "Budget")
+	EPowerlineBudgetAction BudgetAction = EPowerlineBudgetAction::Warn;
+
+	UPROPERTY(config, EditAnywhere, Category = "Budget")
+	FPowerlineBudget DefaultBudget;
+
+	UPROPERTY(config, EditAnywhere, Category = "Budget")
+	TMap<TSoftObjectPtr<UWorld>, FPowerlineBudget> LevelBudgets;
+
+	/** Cell size the cost report groups cables by, matches the default world partition runtime grid. */
+	UPROPERTY(config, EditAnywhere, Category = "Report", meta = (ClampMin = "100.0", Units = "Centimeters"))
+	float ReportCellSize = 25600.f;
+
+	/** Keeps a UPowerlineNetworkGraph asset named <Level>_PowerlineNetwork next to every saved level cables are generated in. */
+	UPROPERTY(config, EditAnywhere, Category = "Network")
+	bool bMaintainNetworkGraph = true;
+
+	/**
+	 * Leaves the splines of generated cables out of cooked levels, the spline mesh segments render without them.
+	 * Editor builds keep the splines for regeneration, the cook log reports what was saved per level.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Cooking")
+	bool bStripCableSplinesOnCook = true;
+
+	/** Actors with this tag and a spline component are the routes the commandlet generates along with -Generate. */
+	UPROPERTY(config, EditAnywhere, Category = "Batch")
+	FName RouteActorTag = TEXT("PowerlineRoute");
+
+	UPROPERTY(config, EditAnywhere, Category = "Batch")
+	FPowerlinePolePlacementSettings BatchPlacement;
+
+	UPROPERTY(config, EditAnywhere, Category = "Batch")
+	FPowerlineGenerationSettings BatchGeneration;
+
+	/**
+	 * Grid the routes are split on between -Workers processes. Each process loads only the cells it owns,
+	 * smaller cells spread a dense area over more processes but cut more spans at a cell border.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Batch", meta = (ClampMin = "1000.0", Units = "Centimeters"))
+	float ShardCellSize = 51200.f;
+
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+};
@@ -0,0 +1,262 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "PowerlineSagTable.h"
+#include "PowerlineToolTypes.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UPowerlineNetworkGraph;
+class UStaticMesh;
+
+UENUM(BlueprintType)
+enum class EPowerlineCollisionPolicy : uint8
+{
+	/** Cables do not collide at all. */
+	None,
+	/** One capsule per segment, all cables of an actor merged into a single body. */
+	CapsuleChain,
+	/** Every spline mesh segment keeps the cable mesh collision, deformed and cooked per segment. */
+	PerSegment,
+};
+
+/** Parameters shared by every cable generated in one call. */
+USTRUCT(BlueprintType)
+struct SIMPLEPOWERLINETOOL_API FPowerlineGenerationSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline")
+	TObjectPtr<UStaticMesh> CableMesh = nullptr;
+
+	/** Number of spline mesh segments per span. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline", meta = (ClampMin = "1"))
+	int32 SplineSegments = 2;
+
+	/** How far the middle of a span hangs below the straight line between its sockets. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline", meta = (ClampMin = "0.0", EditCondition = "!bUseConductorProfile"))
+	float LineBend = 70.f;
+
+	/** Derive each span's sag from its length, height difference and ConductorProfile instead of LineBend. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline")
+	bool bUseConductorProfile = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline", meta = (EditCondition = "bUseConductorProfile"))
+	FPowerlineConductorProfile ConductorProfile;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline")
+	EPowerlineCollisionPolicy CollisionPolicy = EPowerlineCollisionPolicy::CapsuleChain;
+
+	/** Connect matching pole sockets. When off every pole is a single endpoint at its actor location. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline")
+	bool bAttachToSockets = true;
+
+	/** Adds a UPowerlineWindComponent so the cables sway at runtime. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline")
+	bool bAddWindComponent = false;
+
+	/** One spline per socket track running across many poles, instead of one actor with its own splines per pole pair. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline")
+	bool bContinuousCables = false;
+
+	/** Spans owned by one actor in continuous mode, keeps the actors small enough for world partition streaming. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline", meta = (ClampMin = "1", EditCondition = "bContinuousCables"))
+	int32 ContinuousSpansPerActor = 64;
+
+	/**
+	 * Stores the spans as descriptors on a single UPowerlineStreamingComponent instead of spawning their components,
+	 * the cables are then only built at runtime around the viewer.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline")
+	bool bRuntimeStreaming = false;
+
+	/**
+	 * Saves each cable as 16 bit offsets from its straight line on a UPowerlineCompactCableComponent.
+	 * Spline and spline mesh components are not saved, the segments are rebuilt when the level loads.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline", meta = (EditCondition = "!bContinuousCables && !bRuntimeStreaming"))
+	bool bCompactStorage = false;
+
+	/** Records the generated poles and spans here. When unset the level's own graph is used, see bMaintainNetworkGraph in Project Settings. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline")
+	TObjectPtr<UPowerlineNetworkGraph> NetworkGraph = nullptr;
+};
+
+/** How poles are placed along a guide spline. */
+USTRUCT(BlueprintType)
+struct SIMPLEPOWERLINETOOL_API FPowerlinePolePlacementSettings
+{
+	GENERATED_BODY()
+
+	/** Mesh of every placed pole, its sockets are the cable endpoints. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement")
+	TObjectPtr<UStaticMesh> PoleMesh = nullptr;
+
+	/** Wanted distance between poles, adjusted so the first and last pole sit on the spline ends. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement", meta = (ClampMin = "100.0", Units = "Centimeters"))
+	float TargetSpacing = 5000.f;
+
+	/** Drop every pole onto whatever blocks TraceChannel below or above the spline. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement")
+	bool bSnapToTerrain = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement", meta = (EditCondition = "bSnapToTerrain"))
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_WorldStatic;
+
+	/** How far above and below the spline the terrain is searched. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement", meta = (EditCondition = "bSnapToTerrain", ClampMin = "0.0", Units = "Centimeters"))
+	float TraceDistance = 100000.f;
+
+	/** Turn every pole to face along the route. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement")
+	bool bAlignToRoute = true;
+
+	/** Added to the route yaw, for pole meshes whose cross arm is not along Y. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement", meta = (Units = "Degrees"))
+	float YawOffset = 0.f;
+};
+
+/** What a generation call created and how long it took. */
+USTRUCT(BlueprintType)
+struct SIMPLEPOWERLINETOOL_API FPowerlineGenerationResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	TArray<TObjectPtr<AActor>> CreatedActors;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	int32 NumSpans = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	int32 NumSplineComponents = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	int32 NumSplineMeshComponents = 0;
+
+	/** Poles placed along a guide spline, they are instances of one actor in CreatedActors. */
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	int32 NumPlacedPoles = 0;
+
+	/** Time spent placing poles along a guide spline. */
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	float PlacementSeconds = 0.f;
+
+	/** Time spent resolving pole sockets. */
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	float ResolveSeconds = 0.f;
+
+	/** Time spent spawning actors and components. */
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	float GenerateSeconds = 0.f;
+
+	/** Heap allocations made while generating, see UPowerlineGenerationSubsystem::GetNumHeapAllocations. */
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	int64 NumHeapAllocations = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	bool bSuccess = false;
+};
+
+/** What a resolved pole was generated from, so the network graph can find it again. */
+USTRUCT()
+struct SIMPLEPOWERLINETOOL_API FPowerlinePoleRef
+{
+	GENERATED_BODY()
+
+	FPowerlinePoleRef() = default;
+	FPowerlinePoleRef(AActor* InActor, UInstancedStaticMeshComponent* InInstances, int32 InInstanceIndex)
+		: Actor(InActor), Instances(InInstances), InstanceIndex(InInstanceIndex)
+	{
+	}
+
+	UPROPERTY()
+	TWeakObjectPtr<AActor> Actor;
+
+	UPROPERTY()
+	TWeakObjectPtr<UInstancedStaticMeshComponent> Instances;
+
+	UPROPERTY()
+	int32 InstanceIndex = INDEX_NONE;
+};
+
+/**
+ * Validated poles and the predicted cost of connecting them, made without touching the world.
+ * Committing it spawns exactly this plan, nothing is resolved again. It fails once a pole moved, plan again then.
+ */
+USTRUCT(BlueprintType)
+struct SIMPLEPOWERLINETOOL_API FPowerlineGenerationPlan
+{
+	GENERATED_BODY()
+
+	/** False when the poles can not be connected, Error says why. */
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	bool bValid = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	FString Error;
+
+	/** Limits of the level's cable budget the plan would exceed. */
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	TArray<FString> BudgetViolations;
+
+	/** Set when the budget action is Refuse and BudgetViolations is not empty, committing will not spawn anything. */
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	bool bRefusedByBudget = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	int32 NumPoles = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	int32 NumSpans = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	int32 NumSocketsPerPole = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	int32 PredictedActors = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	int32 PredictedComponents = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	int64 PredictedTriangles = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	int32 PredictedDrawCalls = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	float PredictedRenderMemoryMB = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	float PredictedPhysicsMemoryMB = 0.f;
+
+	/** Generation time predicted from the time per component of the previous generations. */
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	float EstimatedSeconds = 0.f;
+
+	/** Time spent making the plan, resolving and validating the poles included. */
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	float PlanSeconds = 0.f;
+
+	UPROPERTY()
+	TWeakObjectPtr<UWorld> World;
+
+	UPROPERTY()
+	FPowerlineGenerationSettings Settings;
+
+	UPROPERTY()
+	TArray<FVector> PoleLocations;
+
+	UPROPERTY()
+	TArray<FVector> SocketLocations;
+
+	UPROPERTY()
+	TArray<FPowerlinePoleRef> PoleRefs;
+
+	/** Transform each pole's sockets were resolved with, one per PoleRefs entry. */
+	UPROPERTY()
+	TArray<FTransform> PoleTransforms;
+};
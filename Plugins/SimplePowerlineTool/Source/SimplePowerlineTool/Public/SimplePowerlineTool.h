@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "PowerlineToolTypes.h"
 
 class FToolBarBuilder;
 class FMenuBuilder;
@@ -19,55 +20,56 @@ public:
 	
 	/** This function will be bound to Command (by default it will bring up plugin window) */
 	void PluginButtonClicked();
-	
+
 private:
 
 	void RegisterMenus();
 
 	TSharedRef<class SDockTab> OnSpawnPluginTab(const class FSpawnTabArgs& SpawnTabArgs);
 
+	/** Generates the planned cables when a plan was made for the current selection, otherwise resolves the selection again. */
 	FReply CreateMeshClicked();
 	FReply RegenerateMeshClicked();
-	void RegenerateMesh();
-
-	void SpawnPowerlineActors();
-
-	void AddSplinePoints(USplineComponent* SplineComp);
-
-	void SetSplinePointsLocation(USplineComponent* SplineComp, int32 Index);
-
-	USplineComponent* CreateSplineComponents(AActor* CableActor);
+	/** Re-applies the segment count and sag shown in the tab to the selected cable actors without respawning them. */
+	FReply ApplySettingsClicked();
+	/** Switches every cable of the level using the mesh of the first selected cable to the selected mesh. */
+	FReply SwapMeshClicked();
 
-	void CreateRootComponent(AActor* CableActor);
+	FReply CheckIntersectionsClicked();
 
-	bool GetSelectedActors();
-	bool CanOperateOnSockets();
+	/** Logs the cable cost of the edited level and shows the totals in the tab. */
+	FReply CostReportClicked();
 
-	void SaveSocketsLocation(UStaticMeshComponent* MeshComponent);
+	/** Validates the selection and shows what generating it would cost, without spawning anything. */
+	FReply PlanClicked();
+	bool IsPlanForSelection() const;
 
-	void CreateSplineMeshComponents(USplineComponent* SplineComp, AActor* CableActor);
-
-	TArray<AActor*> ActorSelection;
-	TArray<FVector> ActorLocation;
-	int32 NumSelectedActors = 0;
-
-	int32 NumSocketPerActor = 0;
-	bool bAttachToSocket = false;
+	FPowerlineGenerationSettings GetToolSettings() const;
 
 	int32 SplineSegments = 2;
 
 	float MeshScale = 0.5f;
-	UStaticMesh* SelectedMesh;
+	UStaticMesh* SelectedMesh = nullptr;
 
 	void OnAssetSelected(const FAssetData& AssetData);
 
 	void OnSliderValueChanged(float Value);
+	void OnSplineSegmentsChanged(int32 Value);
 
 	float LineBend = 70.f;
 
-	FVector LineBendZCalculator(int32 Index, USplineComponent* SplineComp, FVector Location);
+	float IntersectionTolerance = 10.f;
+	float AttachmentClearance = 50.f;
+
+	FText CostSummary;
+
+	/** Last plan made in the tab, dropped when the selection or the settings change. */
+	FPowerlineGenerationPlan Plan;
+	TArray<TWeakObjectPtr<AActor>> PlannedSelection;
 
 
 private:
 	TSharedPtr<class FUICommandList> PluginCommands;
+
+	TSharedPtr<class FPowerlineCookStripper> CookStripper;
 };
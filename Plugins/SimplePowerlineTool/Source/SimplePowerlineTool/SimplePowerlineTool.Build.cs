@@ -26,6 +26,11 @@ public class SimplePowerlineTool : ModuleRules
 			new string[]
 			{
 				"Core",
+				"CoreUObject",
+				"Engine",
+				"EditorSubsystem",
+				"DeveloperSettings",
+				"SimplePowerlineToolRuntime",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -35,12 +40,11 @@ public class SimplePowerlineTool : ModuleRules
 			new string[]
 			{
 				"Projects",
+				"AssetRegistry",
 				"InputCore",
 				"EditorFramework",
 				"UnrealEd",
 				"ToolMenus",
-				"CoreUObject",
-				"Engine",
 				"Slate",
 				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
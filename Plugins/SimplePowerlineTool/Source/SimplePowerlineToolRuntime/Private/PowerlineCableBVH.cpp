@@ -0,0 +1,263 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineCableBVH.h"
+#include "Algo/Partition.h"
+#include "Async/ParallelFor.h"
+
+namespace PowerlineCableBVH
+{
+	// Endpoints closer than this are treated as the same socket/spline point
+	static constexpr float ConnectedEndpointTolerance = 1.f;
+
+	static bool AreConnected(const FPowerlineCableCapsule& A, const FPowerlineCableCapsule& B)
+	{
+		const float ToleranceSquared = FMath::Square(ConnectedEndpointTolerance);
+		return FVector::DistSquared(A.Start, B.Start) < ToleranceSquared
+			|| FVector::DistSquared(A.Start, B.End) < ToleranceSquared
+			|| FVector::DistSquared(A.End, B.Start) < ToleranceSquared
+			|| FVector::DistSquared(A.End, B.End) < ToleranceSquared;
+	}
+}
+
+void FPowerlineCableBVH::Build(TArray<FPowerlineCableCapsule>&& InCapsules)
+{
+	Capsules = MoveTemp(InCapsules);
+	Nodes.Reset();
+	PrimitiveIndices.Reset();
+
+	const int32 NumCapsules = Capsules.Num();
+	if (NumCapsules == 0) return;
+
+	TArray<FBox> PrimitiveBounds;
+	TArray<FVector> Centroids;
+	PrimitiveBounds.SetNumUninitialized(NumCapsules);
+	Centroids.SetNumUninitialized(NumCapsules);
+	PrimitiveIndices.SetNumUninitialized(NumCapsules);
+	for (int32 Index = 0; Index < NumCapsules; Index++)
+	{
+		PrimitiveBounds[Index] = Capsules[Index].GetBounds();
+		Centroids[Index] = (Capsules[Index].Start + Capsules[Index].End) * 0.5f;
+		PrimitiveIndices[Index] = Index;
+	}
+
+	struct FBuildTask
+	{
+		int32 NodeIndex;
+		int32 First;
+		int32 Num;
+	};
+
+	// A binary tree over N primitives never has more than 2 * N - 1 nodes
+	Nodes.Reserve(2 * NumCapsules - 1);
+	Nodes.AddDefaulted();
+
+	TArray<FBuildTask, TInlineAllocator<64>> Stack;
+	Stack.Push({ 0, 0, NumCapsules });
+	while (!Stack.IsEmpty())
+	{
+		const FBuildTask Task = Stack.Pop();
+
+		FBox Bounds(ForceInit);
+		FBox CentroidBounds(ForceInit);
+		for (int32 Index = Task.First; Index < Task.First + Task.Num; Index++)
+		{
+			const int32 Primitive = PrimitiveIndices[Index];
+			Bounds += PrimitiveBounds[Primitive];
+			CentroidBounds += Centroids[Primitive];
+		}
+		Nodes[Task.NodeIndex].Bounds = Bounds;
+
+		if (Task.Num <= MaxLeafSize)
+		{
+			Nodes[Task.NodeIndex].First = Task.First;
+			Nodes[Task.NodeIndex].NumPrimitives = Task.Num;
+			continue;
+		}
+
+		// Split at the middle of the widest centroid axis, fall back to halving the range for degenerate input
+		const FVector CentroidExtent = CentroidBounds.GetExtent();
+		const int32 Axis = CentroidExtent.X >= CentroidExtent.Y
+			? (CentroidExtent.X >= CentroidExtent.Z ? 0 : 2)
+			: (CentroidExtent.Y >= CentroidExtent.Z ? 1 : 2);
+		const double SplitPosition = CentroidBounds.GetCenter()[Axis];
+
+		int32 NumLeft = Algo::Partition(PrimitiveIndices.GetData() + Task.First, Task.Num, [&Centroids, Axis, SplitPosition](int32 Primitive)
+			{
+				return Centroids[Primitive][Axis] < SplitPosition;
+			});
+		if (NumLeft == 0 || NumLeft == Task.Num)
+		{
+			NumLeft = Task.Num / 2;
+		}
+
+		const int32 LeftChild = Nodes.AddDefaulted(2);
+		Nodes[Task.NodeIndex].First = LeftChild;
+		Nodes[Task.NodeIndex].NumPrimitives = 0;
+
+		Stack.Push({ LeftChild, Task.First, NumLeft });
+		Stack.Push({ LeftChild + 1, Task.First + NumLeft, Task.Num - NumLeft });
+	}
+}
+
+template <typename VisitorType>
+void FPowerlineCableBVH::VisitOverlapping(const FBox& Box, VisitorType&& Visitor) const
+{
+	if (Nodes.IsEmpty()) return;
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Push(0);
+	while (!Stack.IsEmpty())
+	{
+		const FNode& Node = Nodes[Stack.Pop()];
+		if (!Node.Bounds.Intersect(Box)) continue;
+
+		if (Node.NumPrimitives > 0)
+		{
+			for (int32 Index = Node.First; Index < Node.First + Node.NumPrimitives; Index++)
+			{
+				Visitor(PrimitiveIndices[Index]);
+			}
+		}
+		else
+		{
+			Stack.Push(Node.First);
+			Stack.Push(Node.First + 1);
+		}
+	}
+}
+
+void FPowerlineCableBVH::FindOverlappingCapsules(const FBox& Box, TArray<int32>& OutCapsules) const
+{
+	VisitOverlapping(Box, [this, &Box, &OutCapsules](int32 Capsule)
+		{
+			if (Capsules[Capsule].GetBounds().Intersect(Box))
+			{
+				OutCapsules.Add(Capsule);
+			}
+		});
+}
+
+bool FPowerlineCableBVH::FindClosestCapsule(const FVector& Point, float MaxDistance, FPowerlineCapsuleHit& OutHit) const
+{
+	if (Nodes.IsEmpty()) return false;
+
+	// Nearer child first, so the best distance shrinks early and prunes most of the tree
+	double BestDistanceSquared = FMath::Square(static_cast<double>(MaxDistance));
+	bool bFound = false;
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Push(0);
+	while (!Stack.IsEmpty())
+	{
+		const FNode& Node = Nodes[Stack.Pop()];
+		if (Node.Bounds.ComputeSquaredDistanceToPoint(Point) > BestDistanceSquared) continue;
+
+		if (Node.NumPrimitives == 0)
+		{
+			const double DistanceA = Nodes[Node.First].Bounds.ComputeSquaredDistanceToPoint(Point);
+			const double DistanceB = Nodes[Node.First + 1].Bounds.ComputeSquaredDistanceToPoint(Point);
+			Stack.Push(DistanceA < DistanceB ? Node.First + 1 : Node.First);
+			Stack.Push(DistanceA < DistanceB ? Node.First : Node.First + 1);
+			continue;
+		}
+
+		for (int32 Index = Node.First; Index < Node.First + Node.NumPrimitives; Index++)
+		{
+			const int32 Capsule = PrimitiveIndices[Index];
+			const FPowerlineCableCapsule& Candidate = Capsules[Capsule];
+			const FVector Closest = FMath::ClosestPointOnSegment(Point, Candidate.Start, Candidate.End);
+			const double SurfaceDistance = FMath::Max(0.0, FVector::Dist(Point, Closest) - Candidate.Radius);
+			if (SurfaceDistance * SurfaceDistance <= BestDistanceSquared)
+			{
+				BestDistanceSquared = SurfaceDistance * SurfaceDistance;
+				OutHit.Capsule = Capsule;
+				OutHit.Location = Closest;
+				OutHit.Distance = FVector::Dist(Point, Closest) - Candidate.Radius;
+				bFound = true;
+			}
+		}
+	}
+	return bFound;
+}
+
+void FPowerlineCableBVH::FindCapsulesInSphere(const FVector& Center, float Radius, TArray<FPowerlineCapsuleHit>& OutHits) const
+{
+	VisitOverlapping(FBox(Center - FVector(Radius), Center + FVector(Radius)), [this, &Center, Radius, &OutHits](int32 Capsule)
+		{
+			const FPowerlineCableCapsule& Candidate = Capsules[Capsule];
+			const FVector Closest = FMath::ClosestPointOnSegment(Center, Candidate.Start, Candidate.End);
+			const float Distance = FVector::Dist(Center, Closest) - Candidate.Radius;
+			if (Distance <= Radius)
+			{
+				OutHits.Add({ Capsule, Closest, Distance });
+			}
+		});
+}
+
+void FPowerlineCableBVH::FindCapsulesInBox(const FBox& Box, TArray<FPowerlineCapsuleHit>& OutHits) const
+{
+	const FVector BoxCenter = Box.GetCenter();
+	VisitOverlapping(Box, [this, &Box, &BoxCenter, &OutHits](int32 Capsule)
+		{
+			const FPowerlineCableCapsule& Candidate = Capsules[Capsule];
+			const FBox ExpandedBox = Box.ExpandBy(Candidate.Radius);
+			const bool bTouching = ExpandedBox.IsInside(Candidate.Start) || ExpandedBox.IsInside(Candidate.End)
+				|| FMath::LineBoxIntersection(ExpandedBox, Candidate.Start, Candidate.End, Candidate.End - Candidate.Start);
+			if (bTouching)
+			{
+				OutHits.Add({ Capsule, FMath::ClosestPointOnSegment(BoxCenter, Candidate.Start, Candidate.End), 0.f });
+			}
+		});
+}
+
+void FPowerlineCableBVH::FindCloseCapsulePairs(float Tolerance, TArray<FPowerlineCapsulePair>& OutPairs) const
+{
+	const int32 NumCapsules = Capsules.Num();
+	if (NumCapsules < 2) return;
+
+	// Every chunk collects its own results, merged in chunk order so the output is deterministic
+	const int32 ChunkSize = 1024;
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumCapsules, ChunkSize);
+	TArray<TArray<FPowerlineCapsulePair>> ChunkPairs;
+	ChunkPairs.SetNum(NumChunks);
+
+	ParallelFor(NumChunks, [this, Tolerance, NumCapsules, ChunkSize, &ChunkPairs](int32 Chunk)
+		{
+			TArray<FPowerlineCapsulePair>& Pairs = ChunkPairs[Chunk];
+			const int32 ChunkEnd = FMath::Min((Chunk + 1) * ChunkSize, NumCapsules);
+			for (int32 CapsuleA = Chunk * ChunkSize; CapsuleA < ChunkEnd; CapsuleA++)
+			{
+				const FPowerlineCableCapsule& A = Capsules[CapsuleA];
+				VisitOverlapping(A.GetBounds().ExpandBy(Tolerance), [this, &A, CapsuleA, Tolerance, &Pairs](int32 CapsuleB)
+					{
+						// Each pair is only tested once
+						if (CapsuleB <= CapsuleA) return;
+
+						const FPowerlineCableCapsule& B = Capsules[CapsuleB];
+						if (PowerlineCableBVH::AreConnected(A, B)) return;
+
+						FVector ClosestA, ClosestB;
+						FMath::SegmentDistToSegmentSafe(A.Start, A.End, B.Start, B.End, ClosestA, ClosestB);
+						const float Separation = FVector::Dist(ClosestA, ClosestB) - A.Radius - B.Radius;
+						if (Separation < Tolerance)
+						{
+							FPowerlineCapsulePair& Pair = Pairs.AddDefaulted_GetRef();
+							Pair.CapsuleA = CapsuleA;
+							Pair.CapsuleB = CapsuleB;
+							Pair.Separation = Separation;
+							Pair.Location = (ClosestA + ClosestB) * 0.5f;
+						}
+					});
+			}
+		});
+
+	int32 NumPairs = OutPairs.Num();
+	for (const TArray<FPowerlineCapsulePair>& Pairs : ChunkPairs)
+	{
+		NumPairs += Pairs.Num();
+	}
+	OutPairs.Reserve(NumPairs);
+	for (const TArray<FPowerlineCapsulePair>& Pairs : ChunkPairs)
+	{
+		OutPairs.Append(Pairs);
+	}
+}
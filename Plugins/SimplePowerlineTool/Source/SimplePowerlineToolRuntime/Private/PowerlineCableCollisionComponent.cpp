@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineCableCollisionComponent.h"
+#include "PowerlineQuerySubsystem.h"
+#include "Components/SplineMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/StaticMesh.h"
+#include "PhysicsEngine/BodySetup.h"
+
+namespace PowerlineCableCollisionComponent
+{
+	static float GetSegmentRadius(const USplineMeshComponent* SplineMeshComp)
+	{
+		const UStaticMesh* Mesh = SplineMeshComp->GetStaticMesh();
+		if (!Mesh) return 0.f;
+
+		// Cable meshes run along X, the cross section lies in the Y/Z plane
+		const FVector Extent = Mesh->GetBounds().BoxExtent;
+		const FVector2D Scale = SplineMeshComp->GetStartScale().ComponentMax(SplineMeshComp->GetEndScale());
+		const FVector ComponentScale = SplineMeshComp->GetComponentScale();
+		return FMath::Max(Extent.Y * Scale.X * ComponentScale.Y, Extent.Z * Scale.Y * ComponentScale.Z);
+	}
+}
+
+UPowerlineCableCollisionComponent::UPowerlineCableCollisionComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	SetGenerateOverlapEvents(false);
+	bHiddenInGame = true;
+	SetCastShadow(false);
+}
+
+void UPowerlineCableCollisionComponent::BuildFromSplineMeshes(TConstArrayView<USplineMeshComponent*> SplineMeshes)
+{
+	const FTransform& ComponentTransform = GetComponentTransform();
+	Capsules.Reset(SplineMeshes.Num());
+	for (const USplineMeshComponent* SplineMesh : SplineMeshes)
+	{
+		if (!SplineMesh) continue;
+
+		const FTransform& SegmentTransform = SplineMesh->GetComponentTransform();
+		FPowerlineCollisionCapsule& Capsule = Capsules.AddDefaulted_GetRef();
+		Capsule.Start = FVector3f(ComponentTransform.InverseTransformPosition(SegmentTransform.TransformPosition(SplineMesh->GetStartPosition())));
+		Capsule.End = FVector3f(ComponentTransform.InverseTransformPosition(SegmentTransform.TransformPosition(SplineMesh->GetEndPosition())));
+		Capsule.Radius = PowerlineCableCollisionComponent::GetSegmentRadius(SplineMesh);
+	}
+
+	UpdateBodySetup();
+	RecreatePhysicsState();
+	UpdateBounds();
+}
+
+void UPowerlineCableCollisionComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UPowerlineQuerySubsystem* QuerySubsystem = GetWorld()->GetSubsystem<UPowerlineQuerySubsystem>())
+	{
+		const FTransform& ComponentTransform = GetComponentTransform();
+		const float RadiusScale = ComponentTransform.GetMaximumAxisScale();
+		TArray<FPowerlineCableCapsule> QueryCapsules;
+		QueryCapsules.Reserve(Capsules.Num());
+		for (const FPowerlineCollisionCapsule& Capsule : Capsules)
+		{
+			FPowerlineCableCapsule& QueryCapsule = QueryCapsules.AddDefaulted_GetRef();
+			QueryCapsule.Start = ComponentTransform.TransformPosition(FVector(Capsule.Start));
+			QueryCapsule.End = ComponentTransform.TransformPosition(FVector(Capsule.End));
+			QueryCapsule.Radius = Capsule.Radius * RadiusScale;
+		}
+		QuerySubsystem->AddCables(this, MoveTemp(QueryCapsules));
+	}
+}
+
+void UPowerlineCableCollisionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UPowerlineQuerySubsystem* QuerySubsystem = GetWorld()->GetSubsystem<UPowerlineQuerySubsystem>())
+	{
+		QuerySubsystem->RemoveCables(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+UBodySetup* UPowerlineCableCollisionComponent::GetBodySetup()
+{
+	// Only the capsules are saved, the body is rebuilt from them after load
+	if (!BodySetup)
+	{
+		UpdateBodySetup();
+	}
+	return BodySetup;
+}
+
+FBoxSphereBounds UPowerlineCableCollisionComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	if (Capsules.IsEmpty()) return FBoxSphereBounds(LocalToWorld.GetLocation(), FVector::ZeroVector, 0.f);
+
+	FBox Box(ForceInit);
+	for (const FPowerlineCollisionCapsule& Capsule : Capsules)
+	{
+		Box += FBox(FVector(Capsule.Start.ComponentMin(Capsule.End) - Capsule.Radius), FVector(Capsule.Start.ComponentMax(Capsule.End) + Capsule.Radius));
+	}
+	return FBoxSphereBounds(Box.TransformBy(LocalToWorld));
+}
+
+void UPowerlineCableCollisionComponent::UpdateBodySetup()
+{
+	if (!BodySetup)
+	{
+		BodySetup = NewObject<UBodySetup>(this, NAME_None, RF_Transient);
+		BodySetup->BodySetupGuid = FGuid::NewGuid();
+		BodySetup->CollisionTraceFlag = CTF_UseSimpleAsComplex;
+		BodySetup->bGenerateMirroredCollision = false;
+		BodySetup->bNeverNeedsCookedCollisionData = true;
+	}
+
+	// Capsules are analytic shapes, nothing has to be cooked
+	FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+	AggGeom.EmptyElements();
+	AggGeom.SphylElems.Reserve(Capsules.Num());
+	for (const FPowerlineCollisionCapsule& Capsule : Capsules)
+	{
+		const FVector Start(Capsule.Start);
+		const FVector End(Capsule.End);
+		const FVector Axis = End - Start;
+		const float Length = Axis.Size();
+		if (Length < KINDA_SMALL_NUMBER) continue;
+
+		FKSphylElem& Elem = AggGeom.SphylElems.Emplace_GetRef(Capsule.Radius, Length);
+		Elem.Center = (Start + End) * 0.5f;
+		Elem.Rotation = FRotationMatrix::MakeFromZ(Axis / Length).Rotator();
+	}
+	BodySetup->InvalidatePhysicsData();
+}
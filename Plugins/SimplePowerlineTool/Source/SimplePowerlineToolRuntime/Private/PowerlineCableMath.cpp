@@ -0,0 +1,39 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineCableMath.h"
+
+float FPowerlineCableMath::GetSagOffset(int32 Index, int32 NumSegments, float Sag)
+{
+	if (Sag < 0.f || NumSegments < 1 || Index <= 0 || Index >= NumSegments) return 0.f;
+
+	// Parabola through both ends that is exactly Sag deep at mid-span, close to the catenary of a taut conductor
+	const float Alpha = static_cast<float>(Index) / NumSegments;
+	return -4.f * Sag * Alpha * (1.f - Alpha);
+}
+
+void FPowerlineCableMath::ComputeSpanPoints(const FVector& Start, const FVector& End, float Sag, int32 NumSegments, TArrayView<FVector> OutPoints)
+{
+	check(OutPoints.Num() == NumSegments + 1);
+
+	const FVector PointDistance = (End - Start) / NumSegments;
+	for (int32 Point = 0; Point <= NumSegments; Point++)
+	{
+		OutPoints[Point] = Start + PointDistance * Point + FVector(0.f, 0.f, GetSagOffset(Point, NumSegments, Sag));
+	}
+}
+
+void FPowerlineCableMath::ComputeTangents(TConstArrayView<FVector> Points, TArrayView<FVector> OutTangents)
+{
+	check(OutTangents.Num() == Points.Num());
+
+	const int32 NumPoints = Points.Num();
+	if (NumPoints < 2) return;
+
+	// Catmull-Rom with zero tension over unit spaced keys, one sided at the ends
+	OutTangents[0] = Points[1] - Points[0];
+	for (int32 Point = 1; Point < NumPoints - 1; Point++)
+	{
+		OutTangents[Point] = (Points[Point + 1] - Points[Point - 1]) * 0.5f;
+	}
+	OutTangents[NumPoints - 1] = Points[NumPoints - 1] - Points[NumPoints - 2];
+}
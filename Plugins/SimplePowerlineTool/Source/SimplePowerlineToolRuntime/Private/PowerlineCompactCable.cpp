@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineCompactCable.h"
+
+void FPowerlineCompactCable::Encode(TConstArrayView<FVector> Points)
+{
+	check(Points.Num() >= 2);
+
+	NumSegments = static_cast<uint16>(FMath::Min(Points.Num() - 1, int32(MAX_uint16)));
+	const FVector StartPoint = Points[0];
+	const FVector EndPoint = Points[NumSegments];
+	Start = FVector3f(StartPoint);
+	End = FVector3f(EndPoint);
+	Offsets.Reset();
+
+	auto GetOffset = [&Points, &StartPoint, &EndPoint, this](int32 Point)
+		{
+			return Points[Point] - FMath::Lerp(StartPoint, EndPoint, double(Point) / NumSegments);
+		};
+
+	double MaxOffset = 0.0;
+	double MaxHorizontalOffset = 0.0;
+	for (int32 Point = 1; Point < NumSegments; Point++)
+	{
+		const FVector Offset = GetOffset(Point);
+		MaxOffset = FMath::Max(MaxOffset, Offset.GetAbsMax());
+		MaxHorizontalOffset = FMath::Max(MaxHorizontalOffset, FMath::Max(FMath::Abs(Offset.X), FMath::Abs(Offset.Y)));
+	}
+
+	Quantum = static_cast<float>(MaxOffset / MAX_int16);
+	if (Quantum <= 0.f)
+	{
+		NumOffsetAxes = 0;
+		Quantum = 0.f;
+		return;
+	}
+
+	// Generated cables only sag, their horizontal offsets round to zero and are not stored at all
+	NumOffsetAxes = MaxHorizontalOffset < Quantum * 0.5f ? 1 : 3;
+	Offsets.Reserve((NumSegments - 1) * NumOffsetAxes);
+	auto Quantize = [this](double Value) { return static_cast<int16>(FMath::Clamp(FMath::RoundToInt32(Value / Quantum), -int32(MAX_int16), int32(MAX_int16))); };
+	for (int32 Point = 1; Point < NumSegments; Point++)
+	{
+		const FVector Offset = GetOffset(Point);
+		if (NumOffsetAxes == 3)
+		{
+			Offsets.Add(Quantize(Offset.X));
+			Offsets.Add(Quantize(Offset.Y));
+		}
+		Offsets.Add(Quantize(Offset.Z));
+	}
+}
+
+void FPowerlineCompactCable::Decode(TArrayView<FVector> OutPoints) const
+{
+	check(OutPoints.Num() == GetNumPoints());
+
+	const FVector StartPoint(Start);
+	const FVector EndPoint(End);
+	OutPoints[0] = StartPoint;
+	for (int32 Point = 1; Point < NumSegments; Point++)
+	{
+		FVector& OutPoint = OutPoints[Point];
+		OutPoint = FMath::Lerp(StartPoint, EndPoint, double(Point) / NumSegments);
+		if (NumOffsetAxes == 1)
+		{
+			OutPoint.Z += Offsets[Point - 1] * Quantum;
+		}
+		else if (NumOffsetAxes == 3)
+		{
+			const int32 First = (Point - 1) * 3;
+			OutPoint += FVector(Offsets[First], Offsets[First + 1], Offsets[First + 2]) * Quantum;
+		}
+	}
+	OutPoints[NumSegments] = EndPoint;
+}
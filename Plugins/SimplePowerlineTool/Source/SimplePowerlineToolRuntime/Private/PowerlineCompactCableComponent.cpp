@@ -0,0 +1,179 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineCompactCableComponent.h"
+#include "PowerlineCableCollisionComponent.h"
+#include "PowerlineCableMath.h"
+#include "PowerlineQuerySubsystem.h"
+#include "PowerlineRuntimeUtils.h"
+#include "Components/SplineMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/StaticMesh.h"
+
+void UPowerlineCompactCableComponent::AddCable(TConstArrayView<FVector> Points)
+{
+	if (Points.Num() < 2) return;
+
+	TArray<FVector, TInlineAllocator<32>> LocalPoints;
+	LocalPoints.SetNumUninitialized(Points.Num());
+	for (int32 Point = 0; Point < Points.Num(); Point++)
+	{
+		LocalPoints[Point] = GetComponentTransform().InverseTransformPosition(Points[Point]);
+	}
+
+	FPowerlineCompactCable& Cable = Cables.AddDefaulted_GetRef();
+	Cable.Encode(LocalPoints);
+	if (IsRegistered())
+	{
+		BuildCableSegments(Cable, Segments.Num());
+	}
+}
+
+void UPowerlineCompactCableComponent::SetCablePoints(int32 Cable, TConstArrayView<FVector> Points)
+{
+	if (Cables.IsValidIndex(Cable) && Points.Num() >= 2)
+	{
+		Cables[Cable].Encode(Points);
+	}
+}
+
+void UPowerlineCompactCableComponent::RebuildSegments()
+{
+	int32 NumSegments = 0;
+	for (const FPowerlineCompactCable& Cable : Cables)
+	{
+		BuildCableSegments(Cable, NumSegments);
+		NumSegments += Cable.NumSegments;
+	}
+	while (Segments.Num() > NumSegments)
+	{
+		if (USplineMeshComponent* Segment = Segments.Pop())
+		{
+			Segment->DestroyComponent();
+		}
+	}
+}
+
+void UPowerlineCompactCableComponent::SetCableMesh(UStaticMesh* NewCableMesh, const FVector2D& NewCableScale)
+{
+	CableMesh = NewCableMesh;
+	CableScale = NewCableScale;
+	for (USplineMeshComponent* Segment : Segments)
+	{
+		if (Segment)
+		{
+			PowerlineRuntime::SetSegmentMesh(Segment, CableMesh, CableScale);
+		}
+	}
+}
+
+float UPowerlineCompactCableComponent::GetMaxError() const
+{
+	float MaxError = 0.f;
+	for (const FPowerlineCompactCable& Cable : Cables)
+	{
+		MaxError = FMath::Max(MaxError, Cable.GetMaxError());
+	}
+	return MaxError;
+}
+
+void UPowerlineCompactCableComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	DestroySegments();
+	RebuildSegments();
+}
+
+void UPowerlineCompactCableComponent::OnUnregister()
+{
+	DestroySegments();
+
+	Super::OnUnregister();
+}
+
+void UPowerlineCompactCableComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UPowerlineQuerySubsystem* QuerySubsystem = GetWorld()->GetSubsystem<UPowerlineQuerySubsystem>();
+	if (!QuerySubsystem || GetOwner()->FindComponentByClass<UPowerlineCableCollisionComponent>()) return;
+
+	const FTransform& ComponentTransform = GetComponentTransform();
+	const float Radius = PowerlineRuntime::GetCableMeshRadius(CableMesh) * CableScale.GetMax() * ComponentTransform.GetMaximumAxisScale();
+	TArray<FPowerlineCableCapsule> Capsules;
+	TArray<FVector, TInlineAllocator<32>> Points;
+	for (const FPowerlineCompactCable& Cable : Cables)
+	{
+		Points.SetNumUninitialized(Cable.GetNumPoints());
+		Cable.Decode(Points);
+		for (int32 Point = 0; Point < Points.Num() - 1; Point++)
+		{
+			FPowerlineCableCapsule& Capsule = Capsules.AddDefaulted_GetRef();
+			Capsule.Start = ComponentTransform.TransformPosition(Points[Point]);
+			Capsule.End = ComponentTransform.TransformPosition(Points[Point + 1]);
+			Capsule.Radius = Radius;
+		}
+	}
+	QuerySubsystem->AddCables(this, MoveTemp(Capsules));
+}
+
+void UPowerlineCompactCableComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UPowerlineQuerySubsystem* QuerySubsystem = GetWorld()->GetSubsystem<UPowerlineQuerySubsystem>())
+	{
+		QuerySubsystem->RemoveCables(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UPowerlineCompactCableComponent::BuildCableSegments(const FPowerlineCompactCable& Cable, int32 FirstSegment)
+{
+	if (!GetOwner()) return;
+
+	TArray<FVector, TInlineAllocator<32>> Points;
+	TArray<FVector, TInlineAllocator<32>> Tangents;
+	Points.SetNumUninitialized(Cable.GetNumPoints());
+	Tangents.SetNumUninitialized(Cable.GetNumPoints());
+	Cable.Decode(Points);
+	FPowerlineCableMath::ComputeTangents(Points, Tangents);
+
+	for (int32 Point = 0; Point < Points.Num() - 1; Point++)
+	{
+		const int32 SegmentIndex = FirstSegment + Point;
+		if (!Segments.IsValidIndex(SegmentIndex))
+		{
+			Segments.Add(CreateSegment());
+		}
+		Segments[SegmentIndex]->SetStartAndEnd(Points[Point], Tangents[Point], Points[Point + 1], Tangents[Point + 1]);
+	}
+}
+
+USplineMeshComponent* UPowerlineCompactCableComponent::CreateSegment()
+{
+	// Segments are rebuilt on every registration and never saved, only the compact cables are
+	USplineMeshComponent* Segment = NewObject<USplineMeshComponent>(GetOwner(), NAME_None, RF_Transient | RF_TextExportTransient | RF_DuplicateTransient);
+	if (!bSegmentCollision)
+	{
+		Segment->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	}
+	Segment->SetMobility(Mobility);
+	Segment->SetupAttachment(this);
+	Segment->SetStartScale(CableScale, false);
+	Segment->SetEndScale(CableScale, false);
+	Segment->SetStaticMesh(CableMesh);
+	Segment->RegisterComponent();
+	return Segment;
+}
+
+void UPowerlineCompactCableComponent::DestroySegments()
+{
+	for (USplineMeshComponent* Segment : Segments)
+	{
+		if (Segment)
+		{
+			Segment->DestroyComponent();
+		}
+	}
+	Segments.Reset();
+}
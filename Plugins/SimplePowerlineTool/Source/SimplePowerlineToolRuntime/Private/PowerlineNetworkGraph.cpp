@@ -0,0 +1,344 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineNetworkGraph.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "GameFramework/Actor.h"
+#include "UObject/ObjectSaveContext.h"
+
+int32 UPowerlineNetworkGraph::AddPole(AActor* Actor, UInstancedStaticMeshComponent* Instances, int32 InstanceIndex, const FVector& Location, int32 NumSockets)
+{
+	FPoleKey Key;
+	Key.Object = Instances ? FSoftObjectPath(Instances) : FSoftObjectPath(Actor);
+	Key.InstanceIndex = Instances ? InstanceIndex : INDEX_NONE;
+	if (Key.Object.IsValid())
+	{
+		if (const int32* ExistingPole = PoleLookup.Find(Key))
+		{
+			Poles[*ExistingPole].Location = Location;
+			return *ExistingPole;
+		}
+	}
+	else if (const int32* ExistingPole = LocationPoleLookup.Find(Location))
+	{
+		return *ExistingPole;
+	}
+
+	FPowerlineGraphPole& Pole = Poles.AddDefaulted_GetRef();
+	Pole.Actor = Instances ? Instances->GetOwner() : Actor;
+	Pole.Instances = Instances;
+	Pole.InstanceIndex = Key.InstanceIndex;
+	Pole.Location = Location;
+	Pole.NumSockets = NumSockets;
+	if (Key.Object.IsValid())
+	{
+		PoleLookup.Add(Key, Poles.Num() - 1);
+	}
+	else
+	{
+		LocationPoleLookup.Add(Location, Poles.Num() - 1);
+	}
+	bAdjacencyDirty = true;
+	return Poles.Num() - 1;
+}
+
+int32 UPowerlineNetworkGraph::AddSpan(int32 PoleA, int32 PoleB, int32 Socket, AActor* CableActor, TConstArrayView<UActorComponent*> Components)
+{
+	check(Poles.IsValidIndex(PoleA) && Poles.IsValidIndex(PoleB));
+
+	FPowerlineGraphSpan& Span = Spans.AddDefaulted_GetRef();
+	Span.PoleA = PoleA;
+	Span.PoleB = PoleB;
+	Span.Socket = Socket;
+	Span.CableActor = CableActor;
+	Span.FirstComponent = SpanComponents.Num();
+	Span.NumComponents = Components.Num();
+	for (UActorComponent* Component : Components)
+	{
+		SpanComponents.Add(Component);
+	}
+
+	AddSpanLookups(Spans.Num() - 1);
+	bAdjacencyDirty = true;
+	return Spans.Num() - 1;
+}
+
+void UPowerlineNetworkGraph::SetSpanComponents(int32 Span, TConstArrayView<UActorComponent*> Components)
+{
+	if (!Spans.IsValidIndex(Span)) return;
+
+	// Same count is written in place, otherwise the range moves to the end and the old one is dropped by CompactSpanComponents
+	FPowerlineGraphSpan& GraphSpan = Spans[Span];
+	for (const TSoftObjectPtr<UActorComponent>& Component : GetSpanComponents(Span))
+	{
+		if (const int32* ComponentSpan = ComponentSpanLookup.Find(Component.ToSoftObjectPath()); ComponentSpan && *ComponentSpan == Span)
+		{
+			ComponentSpanLookup.Remove(Component.ToSoftObjectPath());
+		}
+	}
+	if (GraphSpan.NumComponents != Components.Num())
+	{
+		GraphSpan.FirstComponent = SpanComponents.Num();
+		GraphSpan.NumComponents = Components.Num();
+		SpanComponents.AddDefaulted(Components.Num());
+	}
+	for (int32 Index = 0; Index < Components.Num(); Index++)
+	{
+		SpanComponents[GraphSpan.FirstComponent + Index] = Components[Index];
+		ComponentSpanLookup.FindOrAdd(FSoftObjectPath(Components[Index]), Span);
+	}
+}
+
+void UPowerlineNetworkGraph::RemoveCableActor(const AActor* CableActor)
+{
+	const FSoftObjectPath CablePath(CableActor);
+	if (!CableSpanLookup.Contains(CablePath)) return;
+
+	// Spans are compacted, their component ranges move with them
+	Spans.RemoveAll([&CablePath](const FPowerlineGraphSpan& Span) { return Span.CableActor.ToSoftObjectPath() == CablePath; });
+	CompactSpanComponents();
+
+	// Bare transform poles exist only through their spans, the ones left without any are dropped and the rest renumbered
+	TBitArray<> ReferencedPoles(false, Poles.Num());
+	for (const FPowerlineGraphSpan& Span : Spans)
+	{
+		ReferencedPoles[Span.PoleA] = true;
+		ReferencedPoles[Span.PoleB] = true;
+	}
+	TArray<int32> PoleRemap;
+	TArray<FPowerlineGraphPole> KeptPoles;
+	PoleRemap.SetNumUninitialized(Poles.Num());
+	KeptPoles.Reserve(Poles.Num());
+	for (int32 Pole = 0; Pole < Poles.Num(); Pole++)
+	{
+		const bool bBarePole = Poles[Pole].Actor.IsNull() && Poles[Pole].Instances.IsNull();
+		PoleRemap[Pole] = bBarePole && !ReferencedPoles[Pole] ? INDEX_NONE : KeptPoles.Add(Poles[Pole]);
+	}
+	if (KeptPoles.Num() != Poles.Num())
+	{
+		Poles = MoveTemp(KeptPoles);
+		for (FPowerlineGraphSpan& Span : Spans)
+		{
+			Span.PoleA = PoleRemap[Span.PoleA];
+			Span.PoleB = PoleRemap[Span.PoleB];
+		}
+	}
+
+	RebuildLookups();
+	bAdjacencyDirty = true;
+}
+
+int32 UPowerlineNetworkGraph::FindPole(const AActor* Actor, int32 InstanceIndex) const
+{
+	if (!Actor) return INDEX_NONE;
+
+	if (InstanceIndex != INDEX_NONE)
+	{
+		if (const UInstancedStaticMeshComponent* Instances = Actor->FindComponentByClass<UInstancedStaticMeshComponent>())
+		{
+			return FindInstancePole(Instances, InstanceIndex);
+		}
+	}
+
+	FPoleKey Key;
+	Key.Object = FSoftObjectPath(Actor);
+	const int32* Pole = PoleLookup.Find(Key);
+	return Pole ? *Pole : INDEX_NONE;
+}
+
+int32 UPowerlineNetworkGraph::FindInstancePole(const UInstancedStaticMeshComponent* Instances, int32 InstanceIndex) const
+{
+	FPoleKey Key;
+	Key.Object = FSoftObjectPath(Instances);
+	Key.InstanceIndex = InstanceIndex;
+	const int32* Pole = PoleLookup.Find(Key);
+	return Pole ? *Pole : INDEX_NONE;
+}
+
+TConstArrayView<int32> UPowerlineNetworkGraph::GetPoleSpans(int32 Pole) const
+{
+	if (bAdjacencyDirty)
+	{
+		RebuildAdjacency();
+	}
+	if (!Poles.IsValidIndex(Pole)) return TConstArrayView<int32>();
+
+	return TConstArrayView<int32>(PoleSpanIndices.GetData() + PoleSpanOffsets[Pole], PoleSpanOffsets[Pole + 1] - PoleSpanOffsets[Pole]);
+}
+
+TConstArrayView<TSoftObjectPtr<UActorComponent>> UPowerlineNetworkGraph::GetSpanComponents(int32 Span) const
+{
+	if (!Spans.IsValidIndex(Span)) return TConstArrayView<TSoftObjectPtr<UActorComponent>>();
+
+	return TConstArrayView<TSoftObjectPtr<UActorComponent>>(SpanComponents.GetData() + Spans[Span].FirstComponent, Spans[Span].NumComponents);
+}
+
+TConstArrayView<int32> UPowerlineNetworkGraph::FindCableSpans(const AActor* CableActor) const
+{
+	const TArray<int32>* CableSpans = CableSpanLookup.Find(FSoftObjectPath(CableActor));
+	return CableSpans ? TConstArrayView<int32>(*CableSpans) : TConstArrayView<int32>();
+}
+
+int32 UPowerlineNetworkGraph::FindComponentSpan(const UActorComponent* Component) const
+{
+	const int32* Span = ComponentSpanLookup.Find(FSoftObjectPath(Component));
+	return Span ? *Span : INDEX_NONE;
+}
+
+TArray<AActor*> UPowerlineNetworkGraph::GetCableActorsOfPoles(const TArray<AActor*>& PoleActors)
+{
+	TArray<AActor*> CableActors;
+	auto AddPoleCables = [this, &CableActors](int32 Pole)
+		{
+			for (int32 Span : GetPoleSpans(Pole))
+			{
+				if (AActor* CableActor = Spans[Span].CableActor.Get())
+				{
+					CableActors.AddUnique(CableActor);
+				}
+			}
+		};
+
+	for (const AActor* PoleActor : PoleActors)
+	{
+		if (!PoleActor) continue;
+
+		// An instanced pole forest counts with every one of its instances
+		if (const UInstancedStaticMeshComponent* Instances = PoleActor->FindComponentByClass<UInstancedStaticMeshComponent>())
+		{
+			for (int32 Instance = 0; Instance < Instances->GetInstanceCount(); Instance++)
+			{
+				const int32 Pole = FindInstancePole(Instances, Instance);
+				if (Pole != INDEX_NONE)
+				{
+					AddPoleCables(Pole);
+				}
+			}
+		}
+
+		const int32 Pole = FindPole(PoleActor);
+		if (Pole != INDEX_NONE)
+		{
+			AddPoleCables(Pole);
+		}
+	}
+	return CableActors;
+}
+
+void UPowerlineNetworkGraph::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	CompactSpanComponents();
+	if (bAdjacencyDirty)
+	{
+		RebuildAdjacency();
+	}
+}
+
+void UPowerlineNetworkGraph::PostLoad()
+{
+	Super::PostLoad();
+
+	// Graphs saved before they were created transactional would not record Modify for undo
+	SetFlags(RF_Transactional);
+
+	// Adjacency rows are saved, only the path lookups have to be rebuilt. Rows that do not cover every span twice,
+	// e.g. from a graph saved before PreSave kept them current, are rebuilt on the first query
+	RebuildLookups();
+	bAdjacencyDirty = PoleSpanOffsets.Num() != Poles.Num() + 1 || PoleSpanOffsets.Last() != Spans.Num() * 2 || PoleSpanIndices.Num() != Spans.Num() * 2;
+	for (int32 Index = 0; !bAdjacencyDirty && Index < PoleSpanIndices.Num(); Index++)
+	{
+		bAdjacencyDirty = !Spans.IsValidIndex(PoleSpanIndices[Index]);
+	}
+}
+
+#if WITH_EDITOR
+void UPowerlineNetworkGraph::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	RebuildLookups();
+	bAdjacencyDirty = true;
+}
+#endif
+
+void UPowerlineNetworkGraph::RebuildAdjacency() const
+{
+	// Counting sort of span ends by pole, every span appears in the rows of both its poles
+	PoleSpanOffsets.Reset(Poles.Num() + 1);
+	PoleSpanOffsets.AddZeroed(Poles.Num() + 1);
+	for (const FPowerlineGraphSpan& Span : Spans)
+	{
+		PoleSpanOffsets[Span.PoleA + 1]++;
+		PoleSpanOffsets[Span.PoleB + 1]++;
+	}
+	for (int32 Pole = 0; Pole < Poles.Num(); Pole++)
+	{
+		PoleSpanOffsets[Pole + 1] += PoleSpanOffsets[Pole];
+	}
+
+	TArray<int32> Cursor(PoleSpanOffsets.GetData(), Poles.Num());
+	PoleSpanIndices.SetNumUninitialized(Spans.Num() * 2);
+	for (int32 Span = 0; Span < Spans.Num(); Span++)
+	{
+		PoleSpanIndices[Cursor[Spans[Span].PoleA]++] = Span;
+		PoleSpanIndices[Cursor[Spans[Span].PoleB]++] = Span;
+	}
+	bAdjacencyDirty = false;
+}
+
+void UPowerlineNetworkGraph::CompactSpanComponents()
+{
+	int32 NumUsedComponents = 0;
+	for (const FPowerlineGraphSpan& Span : Spans)
+	{
+		NumUsedComponents += Span.NumComponents;
+	}
+	if (NumUsedComponents == SpanComponents.Num()) return;
+
+	TArray<TSoftObjectPtr<UActorComponent>> KeptComponents;
+	KeptComponents.Reserve(NumUsedComponents);
+	for (FPowerlineGraphSpan& Span : Spans)
+	{
+		const int32 FirstComponent = KeptComponents.Num();
+		KeptComponents.Append(SpanComponents.GetData() + Span.FirstComponent, Span.NumComponents);
+		Span.FirstComponent = FirstComponent;
+	}
+	SpanComponents = MoveTemp(KeptComponents);
+}
+
+void UPowerlineNetworkGraph::RebuildLookups()
+{
+	PoleLookup.Reset();
+	LocationPoleLookup.Reset();
+	for (int32 Pole = 0; Pole < Poles.Num(); Pole++)
+	{
+		FPoleKey Key;
+		Key.Object = Poles[Pole].Instances.IsNull() ? Poles[Pole].Actor.ToSoftObjectPath() : Poles[Pole].Instances.ToSoftObjectPath();
+		Key.InstanceIndex = Poles[Pole].InstanceIndex;
+		if (Key.Object.IsValid())
+		{
+			PoleLookup.Add(Key, Pole);
+		}
+		else
+		{
+			LocationPoleLookup.Add(Poles[Pole].Location, Pole);
+		}
+	}
+
+	CableSpanLookup.Reset();
+	ComponentSpanLookup.Reset();
+	for (int32 Span = 0; Span < Spans.Num(); Span++)
+	{
+		AddSpanLookups(Span);
+	}
+}
+
+void UPowerlineNetworkGraph::AddSpanLookups(int32 Span)
+{
+	CableSpanLookup.FindOrAdd(Spans[Span].CableActor.ToSoftObjectPath()).Add(Span);
+	for (const TSoftObjectPtr<UActorComponent>& Component : GetSpanComponents(Span))
+	{
+		ComponentSpanLookup.FindOrAdd(Component.ToSoftObjectPath(), Span);
+	}
+}
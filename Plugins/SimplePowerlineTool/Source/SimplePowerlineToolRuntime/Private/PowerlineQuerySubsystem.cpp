@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineQuerySubsystem.h"
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "Misc/ScopeRWLock.h"
+
+void UPowerlineQuerySubsystem::AddCables(UActorComponent* Component, TArray<FPowerlineCableCapsule>&& Capsules)
+{
+	if (!Component || Capsules.IsEmpty()) return;
+
+	ComponentCables.Add(Component, MoveTemp(Capsules));
+	bDirty = true;
+}
+
+void UPowerlineQuerySubsystem::RemoveCables(UActorComponent* Component)
+{
+	if (ComponentCables.Remove(Component) == 0) return;
+
+	// The index keeps its segments until the next rebuild, hits on them are dropped
+	FRWScopeLock WriteLock(Lock, SLT_Write);
+	for (UActorComponent*& Owner : Owners)
+	{
+		if (Owner == Component)
+		{
+			Owner = nullptr;
+		}
+	}
+	bDirty = true;
+}
+
+void UPowerlineQuerySubsystem::RebuildIfDirty()
+{
+	if (!bDirty) return;
+
+	int32 NumCapsules = 0;
+	for (const TPair<UActorComponent*, TArray<FPowerlineCableCapsule>>& Pair : ComponentCables)
+	{
+		NumCapsules += Pair.Value.Num();
+	}
+
+	TArray<UActorComponent*> NewOwners;
+	TArray<FPowerlineCableCapsule> Capsules;
+	NewOwners.Reserve(ComponentCables.Num());
+	Capsules.Reserve(NumCapsules);
+	for (const TPair<UActorComponent*, TArray<FPowerlineCableCapsule>>& Pair : ComponentCables)
+	{
+		const int32 OwnerIndex = NewOwners.Add(Pair.Key);
+		for (const FPowerlineCableCapsule& Capsule : Pair.Value)
+		{
+			Capsules.Add_GetRef(Capsule).OwnerIndex = OwnerIndex;
+		}
+	}
+
+	// Built outside the lock, queries on other threads only wait for the swap
+	FPowerlineCableBVH NewBVH;
+	NewBVH.Build(MoveTemp(Capsules));
+
+	FRWScopeLock WriteLock(Lock, SLT_Write);
+	BVH = MoveTemp(NewBVH);
+	Owners = MoveTemp(NewOwners);
+	bDirty = false;
+}
+
+void UPowerlineQuerySubsystem::ToCableHits(TConstArrayView<FPowerlineCapsuleHit> Hits, TArray<FPowerlineCableHit>& OutHits) const
+{
+	for (const FPowerlineCapsuleHit& Hit : Hits)
+	{
+		UActorComponent* Owner = Owners[BVH.GetCapsules()[Hit.Capsule].OwnerIndex];
+		if (!Owner) continue;
+
+		FPowerlineCableHit& CableHit = OutHits.AddDefaulted_GetRef();
+		CableHit.CableActor = Owner->GetOwner();
+		CableHit.Component = Owner;
+		CableHit.Location = Hit.Location;
+		CableHit.Distance = Hit.Distance;
+	}
+}
+
+bool UPowerlineQuerySubsystem::FindClosestCable(const FVector& Location, float MaxDistance, FPowerlineCableHit& OutHit) const
+{
+	FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+	FPowerlineCapsuleHit Hit;
+	if (!BVH.FindClosestCapsule(Location, MaxDistance, Hit)) return false;
+
+	TArray<FPowerlineCableHit, TInlineAllocator<1>> CableHits;
+	ToCableHits(MakeArrayView(&Hit, 1), CableHits);
+	if (CableHits.IsEmpty()) return false;
+
+	OutHit = CableHits[0];
+	return true;
+}
+
+void UPowerlineQuerySubsystem::FindCablesInSphere(const FVector& Center, float Radius, TArray<FPowerlineCableHit>& OutHits) const
+{
+	FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+	TArray<FPowerlineCapsuleHit, TInlineAllocator<16>> Hits;
+	BVH.FindCapsulesInSphere(Center, Radius, Hits);
+	ToCableHits(Hits, OutHits);
+}
+
+void UPowerlineQuerySubsystem::FindCablesInBox(const FBox& Box, TArray<FPowerlineCableHit>& OutHits) const
+{
+	FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+	TArray<FPowerlineCapsuleHit, TInlineAllocator<16>> Hits;
+	BVH.FindCapsulesInBox(Box, Hits);
+	ToCableHits(Hits, OutHits);
+}
+
+void UPowerlineQuerySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	RebuildIfDirty();
+}
+
+TStatId UPowerlineQuerySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPowerlineQuerySubsystem, STATGROUP_Tickables);
+}
+
+bool UPowerlineQuerySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineRuntimeUtils.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/SplineMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+FVector PowerlineRuntime::GetViewLocation(const UWorld* World)
+{
+	if (APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr)
+	{
+		if (PlayerController->PlayerCameraManager)
+		{
+			return PlayerController->PlayerCameraManager->GetCameraLocation();
+		}
+	}
+	return FVector::ZeroVector;
+}
+
+float PowerlineRuntime::GetCableMeshRadius(const UStaticMesh* CableMesh)
+{
+	if (!CableMesh) return 0.f;
+
+	const FVector Extent = CableMesh->GetBounds().BoxExtent;
+	return FMath::Max(Extent.Y, Extent.Z);
+}
+
+void PowerlineRuntime::SetSegmentMesh(USplineMeshComponent* Segment, UStaticMesh* CableMesh, const FVector2D& Scale)
+{
+	const bool bScaleChanged = !Segment->GetStartScale().Equals(Scale) || !Segment->GetEndScale().Equals(Scale);
+	Segment->SetStartScale(Scale, false);
+	Segment->SetEndScale(Scale, false);
+
+	// A new mesh recreates both by itself, a scale change alone has to ask for it
+	if (!Segment->SetStaticMesh(CableMesh) && bScaleChanged)
+	{
+		Segment->UpdateRenderStateAndCollision();
+	}
+}
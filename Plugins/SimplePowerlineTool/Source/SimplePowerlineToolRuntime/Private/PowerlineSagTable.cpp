@@ -0,0 +1,118 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineSagTable.h"
+#include <cmath>
+
+namespace PowerlineSagTable
+{
+	static constexpr double Gravity = 9.81;
+	static constexpr double CentimetersPerMeter = 100.0;
+
+	// Catenary parameter bounds, beyond them cosh overflows or the cable is straight for any game scale span
+	static constexpr double MinCatenaryRatio = 1.0 / 200.0;
+	static constexpr double MaxCatenaryParameter = 1.0e9;
+	static constexpr int32 SolverIterations = 64;
+
+	/** Chord projection of the cable, 2a sinh(S / 2a), falls from infinity to S as a grows. */
+	static double GetHorizontalArc(double CatenaryParameter, double Span)
+	{
+		return 2.0 * CatenaryParameter * std::sinh(Span / (2.0 * CatenaryParameter));
+	}
+
+	/** Sag below the chord at mid span of the catenary y = a cosh((x - x0) / a) + c through (0, 0) and (S, h). */
+	static double GetMidSpanSag(double CatenaryParameter, double Span, double Height)
+	{
+		const double LowestPoint = Span * 0.5 - CatenaryParameter * std::asinh(Height / GetHorizontalArc(CatenaryParameter, Span));
+		const double MidHeight = CatenaryParameter * (std::cosh((Span * 0.5 - LowestPoint) / CatenaryParameter) - std::cosh(LowestPoint / CatenaryParameter));
+		return Height * 0.5 - MidHeight;
+	}
+}
+
+bool FPowerlineConductorProfile::operator==(const FPowerlineConductorProfile& Other) const
+{
+	return MassPerMeter == Other.MassPerMeter
+		&& Tension == Other.Tension
+		&& Temperature == Other.Temperature
+		&& ReferenceTemperature == Other.ReferenceTemperature
+		&& ThermalExpansion == Other.ThermalExpansion
+		&& MaxSpanLength == Other.MaxSpanLength
+		&& MaxHeightDifference == Other.MaxHeightDifference;
+}
+
+void FPowerlineSagTable::Build(const FPowerlineConductorProfile& InProfile)
+{
+	Profile = InProfile;
+	Sags.SetNumUninitialized(NumLengthSamples * NumHeightSamples);
+	for (int32 HeightSample = 0; HeightSample < NumHeightSamples; HeightSample++)
+	{
+		const float HeightDifference = Profile.MaxHeightDifference * HeightSample / (NumHeightSamples - 1);
+		for (int32 LengthSample = 0; LengthSample < NumLengthSamples; LengthSample++)
+		{
+			const float SpanLength = Profile.MaxSpanLength * LengthSample / (NumLengthSamples - 1);
+			Sags[HeightSample * NumLengthSamples + LengthSample] = ComputeSag(Profile, SpanLength, HeightDifference);
+		}
+	}
+}
+
+float FPowerlineSagTable::GetSag(float SpanLength, float HeightDifference) const
+{
+	if (Sags.IsEmpty()) return 0.f;
+
+	// Sag does not depend on which end is higher
+	const float LengthPosition = FMath::Clamp(SpanLength / Profile.MaxSpanLength, 0.f, 1.f) * (NumLengthSamples - 1);
+	const float HeightPosition = Profile.MaxHeightDifference > 0.f ? FMath::Clamp(FMath::Abs(HeightDifference) / Profile.MaxHeightDifference, 0.f, 1.f) * (NumHeightSamples - 1) : 0.f;
+
+	const int32 Length0 = FMath::Min(FMath::FloorToInt(LengthPosition), NumLengthSamples - 2);
+	const int32 Height0 = FMath::Min(FMath::FloorToInt(HeightPosition), NumHeightSamples - 2);
+	const float LengthAlpha = LengthPosition - Length0;
+	const float HeightAlpha = HeightPosition - Height0;
+
+	const float* Row0 = Sags.GetData() + Height0 * NumLengthSamples;
+	const float* Row1 = Row0 + NumLengthSamples;
+	return FMath::BiLerp(Row0[Length0], Row0[Length0 + 1], Row1[Length0], Row1[Length0 + 1], LengthAlpha, HeightAlpha);
+}
+
+float FPowerlineSagTable::GetSag(const FVector& Start, const FVector& End) const
+{
+	const FVector Delta = End - Start;
+	return GetSag(Delta.Size2D(), Delta.Z);
+}
+
+float FPowerlineSagTable::ComputeSag(const FPowerlineConductorProfile& Profile, float SpanLength, float HeightDifference)
+{
+	const double Span = SpanLength / PowerlineSagTable::CentimetersPerMeter;
+	const double Height = FMath::Abs(HeightDifference) / PowerlineSagTable::CentimetersPerMeter;
+	if (Span <= UE_KINDA_SMALL_NUMBER) return 0.f;
+
+	const double MinParameter = Span * PowerlineSagTable::MinCatenaryRatio;
+	double CatenaryParameter = FMath::Max<double>(Profile.Tension / (Profile.MassPerMeter * PowerlineSagTable::Gravity), MinParameter);
+
+	// Temperature changes the conductor length, find the catenary of the new length by bisecting its parameter
+	const double ThermalStrain = Profile.ThermalExpansion * (Profile.Temperature - Profile.ReferenceTemperature);
+	if (ThermalStrain != 0.0)
+	{
+		const double StrungLength = FMath::Sqrt(FMath::Square(Height) + FMath::Square(PowerlineSagTable::GetHorizontalArc(CatenaryParameter, Span)));
+		const double Length = StrungLength * (1.0 + ThermalStrain);
+		const double HorizontalArcSquared = FMath::Square(Length) - FMath::Square(Height);
+		if (HorizontalArcSquared <= FMath::Square(Span)) return 0.f;
+
+		const double TargetArc = FMath::Sqrt(HorizontalArcSquared);
+		double Low = MinParameter;
+		double High = PowerlineSagTable::MaxCatenaryParameter;
+		for (int32 Iteration = 0; Iteration < PowerlineSagTable::SolverIterations; Iteration++)
+		{
+			const double Mid = FMath::Sqrt(Low * High);
+			if (PowerlineSagTable::GetHorizontalArc(Mid, Span) > TargetArc)
+			{
+				Low = Mid;
+			}
+			else
+			{
+				High = Mid;
+			}
+		}
+		CatenaryParameter = FMath::Sqrt(Low * High);
+	}
+
+	return static_cast<float>(PowerlineSagTable::GetMidSpanSag(CatenaryParameter, Span, Height) * PowerlineSagTable::CentimetersPerMeter);
+}
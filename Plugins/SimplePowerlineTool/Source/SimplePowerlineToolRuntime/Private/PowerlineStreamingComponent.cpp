@@ -0,0 +1,281 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineStreamingComponent.h"
+#include "PowerlineCableBVH.h"
+#include "PowerlineCableMath.h"
+#include "PowerlineQuerySubsystem.h"
+#include "PowerlineRuntimeUtils.h"
+#include "Components/SplineMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Tasks/Task.h"
+
+namespace PowerlineStreamingComponent
+{
+	// Streaming decisions do not need to follow the camera every frame
+	static constexpr float StreamingTickInterval = 0.1f;
+
+	static FIntPoint GetGridCell(const FVector& Location, float CellSize)
+	{
+		return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+	}
+}
+
+UPowerlineStreamingComponent::UPowerlineStreamingComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickInterval = PowerlineStreamingComponent::StreamingTickInterval;
+}
+
+void UPowerlineStreamingComponent::AddSpan(const FVector& Start, const FVector& End, float Sag, int32 NumSegments)
+{
+	FPowerlineSpanDescriptor& Span = Spans.AddDefaulted_GetRef();
+	Span.Start = FVector3f(GetComponentTransform().InverseTransformPosition(Start));
+	Span.End = FVector3f(GetComponentTransform().InverseTransformPosition(End));
+	Span.Sag = Sag;
+	Span.NumSegments = static_cast<uint16>(FMath::Clamp(NumSegments, 1, int32(MAX_uint16)));
+
+	if (HasBegunPlay())
+	{
+		SpanRuntime.AddDefaulted();
+		BuildSpanGrid();
+	}
+}
+
+void UPowerlineStreamingComponent::SetSpanShape(int32 Span, float Sag, int32 NumSegments)
+{
+	if (!Spans.IsValidIndex(Span)) return;
+
+	Spans[Span].Sag = Sag;
+	Spans[Span].NumSegments = static_cast<uint16>(FMath::Clamp(NumSegments, 1, int32(MAX_uint16)));
+}
+
+void UPowerlineStreamingComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	BuiltSpans = MakeShared<FBuiltSpanQueue, ESPMode::ThreadSafe>();
+	SpanRuntime.SetNum(Spans.Num());
+	BuildSpanGrid();
+
+	// Every span is indexed whether it is built or not, queries should not depend on where the viewer is
+	if (UPowerlineQuerySubsystem* QuerySubsystem = GetWorld()->GetSubsystem<UPowerlineQuerySubsystem>())
+	{
+		TArray<FPowerlineCableCapsule> Capsules;
+		GetSpanCapsules(Capsules);
+		QuerySubsystem->AddCables(this, MoveTemp(Capsules));
+	}
+}
+
+void UPowerlineStreamingComponent::GetSpanCapsules(TArray<FPowerlineCableCapsule>& OutCapsules) const
+{
+	const FTransform& ComponentTransform = GetComponentTransform();
+	const float Radius = PowerlineRuntime::GetCableMeshRadius(CableMesh) * CableScale.GetMax() * ComponentTransform.GetMaximumAxisScale();
+	TArray<FVector, TInlineAllocator<32>> Points;
+	for (const FPowerlineSpanDescriptor& Span : Spans)
+	{
+		Points.SetNumUninitialized(Span.NumSegments + 1);
+		FPowerlineCableMath::ComputeSpanPoints(FVector(Span.Start), FVector(Span.End), Span.Sag, Span.NumSegments, Points);
+		for (int32 Point = 0; Point < Span.NumSegments; Point++)
+		{
+			FPowerlineCableCapsule& Capsule = OutCapsules.AddDefaulted_GetRef();
+			Capsule.Start = ComponentTransform.TransformPosition(Points[Point]);
+			Capsule.End = ComponentTransform.TransformPosition(Points[Point + 1]);
+			Capsule.Radius = Radius;
+		}
+	}
+}
+
+void UPowerlineStreamingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Tasks still running keep the queue alive on their own, their results are simply never read
+	BuiltSpans.Reset();
+	if (UPowerlineQuerySubsystem* QuerySubsystem = GetWorld()->GetSubsystem<UPowerlineQuerySubsystem>())
+	{
+		QuerySubsystem->RemoveCables(this);
+	}
+	while (!ActiveSpans.IsEmpty())
+	{
+		ReleaseSpan(ActiveSpans.Last());
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UPowerlineStreamingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (Spans.IsEmpty() || !BuiltSpans) return;
+
+	const FVector ViewLocation = GetComponentTransform().InverseTransformPosition(PowerlineRuntime::GetViewLocation(GetWorld()));
+	ReleaseSpansOutOfRange(ViewLocation);
+	RequestSpansInRange(ViewLocation);
+	ApplyBuiltSpans();
+}
+
+void UPowerlineStreamingComponent::BuildSpanGrid()
+{
+	SpanGrid.Reset();
+
+	// A span is found from every cell its 2D bounds touch, so a query only has to look at the cells around the viewer
+	GridCellSize = FMath::Max(StreamingRadius, 1000.f);
+	for (int32 Span = 0; Span < Spans.Num(); Span++)
+	{
+		const FVector Start(Spans[Span].Start);
+		const FVector End(Spans[Span].End);
+		const FIntPoint MinCell = PowerlineStreamingComponent::GetGridCell(Start.ComponentMin(End), GridCellSize);
+		const FIntPoint MaxCell = PowerlineStreamingComponent::GetGridCell(Start.ComponentMax(End), GridCellSize);
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+			{
+				SpanGrid.FindOrAdd(FIntPoint(X, Y)).Add(Span);
+			}
+		}
+	}
+}
+
+void UPowerlineStreamingComponent::RequestSpansInRange(const FVector& ViewLocation)
+{
+	const FIntPoint MinCell = PowerlineStreamingComponent::GetGridCell(ViewLocation - FVector(StreamingRadius), GridCellSize);
+	const FIntPoint MaxCell = PowerlineStreamingComponent::GetGridCell(ViewLocation + FVector(StreamingRadius), GridCellSize);
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			const TArray<int32>* CellSpans = SpanGrid.Find(FIntPoint(X, Y));
+			if (!CellSpans) continue;
+
+			for (int32 Span : *CellSpans)
+			{
+				FSpanRuntime& Runtime = SpanRuntime[Span];
+				if (Runtime.State != ESpanState::Unloaded || GetSpanDistance(Span, ViewLocation) > StreamingRadius) continue;
+
+				Runtime.State = ESpanState::Building;
+				Runtime.Request++;
+				ActiveSpans.Add(Span);
+
+				UE::Tasks::Launch(UE_SOURCE_LOCATION, [Queue = BuiltSpans, Descriptor = Spans[Span], Span, Request = Runtime.Request]()
+					{
+						FBuiltSpan Built;
+						Built.Span = Span;
+						Built.Request = Request;
+						Built.Points.SetNumUninitialized(Descriptor.NumSegments + 1);
+						Built.Tangents.SetNumUninitialized(Descriptor.NumSegments + 1);
+						FPowerlineCableMath::ComputeSpanPoints(FVector(Descriptor.Start), FVector(Descriptor.End), Descriptor.Sag, Descriptor.NumSegments, Built.Points);
+						FPowerlineCableMath::ComputeTangents(Built.Points, Built.Tangents);
+						Queue->Enqueue(MoveTemp(Built));
+					});
+			}
+		}
+	}
+}
+
+void UPowerlineStreamingComponent::ReleaseSpansOutOfRange(const FVector& ViewLocation)
+{
+	const float ReleaseDistance = StreamingRadius + ReleaseMargin;
+	for (int32 Index = ActiveSpans.Num() - 1; Index >= 0; Index--)
+	{
+		if (GetSpanDistance(ActiveSpans[Index], ViewLocation) > ReleaseDistance)
+		{
+			ReleaseSpan(ActiveSpans[Index]);
+		}
+	}
+}
+
+void UPowerlineStreamingComponent::ApplyBuiltSpans()
+{
+	FBuiltSpan Built;
+	for (int32 NumApplied = 0; NumApplied < MaxSpansAppliedPerTick && BuiltSpans->Dequeue(Built); NumApplied++)
+	{
+		FSpanRuntime& Runtime = SpanRuntime[Built.Span];
+		if (Runtime.State != ESpanState::Building || Runtime.Request != Built.Request) continue;
+
+		TArray<TWeakObjectPtr<USplineMeshComponent>>& Segments = LoadedSegments.Add(Built.Span);
+		Segments.Reserve(Built.Points.Num() - 1);
+		for (int32 Point = 0; Point < Built.Points.Num() - 1; Point++)
+		{
+			USplineMeshComponent* Segment = AcquireSegment();
+			Segment->SetStartAndEnd(Built.Points[Point], Built.Tangents[Point], Built.Points[Point + 1], Built.Tangents[Point + 1]);
+			Segment->SetVisibility(true);
+			Segments.Add(Segment);
+		}
+		Runtime.State = ESpanState::Loaded;
+	}
+}
+
+void UPowerlineStreamingComponent::ReleaseSpan(int32 Span)
+{
+	FSpanRuntime& Runtime = SpanRuntime[Span];
+	Runtime.State = ESpanState::Unloaded;
+	ActiveSpans.RemoveSingleSwap(Span);
+
+	TArray<TWeakObjectPtr<USplineMeshComponent>> Segments;
+	if (LoadedSegments.RemoveAndCopyValue(Span, Segments))
+	{
+		for (const TWeakObjectPtr<USplineMeshComponent>& Segment : Segments)
+		{
+			ReleaseSegment(Segment.Get());
+		}
+	}
+}
+
+float UPowerlineStreamingComponent::GetSpanDistance(int32 Span, const FVector& ViewLocation) const
+{
+	return FMath::PointDistToSegment(ViewLocation, FVector(Spans[Span].Start), FVector(Spans[Span].End));
+}
+
+void UPowerlineStreamingComponent::SetCableMesh(UStaticMesh* NewCableMesh, const FVector2D& NewCableScale)
+{
+	CableMesh = NewCableMesh;
+	CableScale = NewCableScale;
+	for (const TPair<int32, TArray<TWeakObjectPtr<USplineMeshComponent>>>& Pair : LoadedSegments)
+	{
+		for (const TWeakObjectPtr<USplineMeshComponent>& Segment : Pair.Value)
+		{
+			if (Segment.IsValid())
+			{
+				PowerlineRuntime::SetSegmentMesh(Segment.Get(), CableMesh, CableScale);
+			}
+		}
+	}
+	for (USplineMeshComponent* Segment : SegmentPool)
+	{
+		if (Segment)
+		{
+			PowerlineRuntime::SetSegmentMesh(Segment, CableMesh, CableScale);
+		}
+	}
+}
+
+USplineMeshComponent* UPowerlineStreamingComponent::AcquireSegment()
+{
+	if (!SegmentPool.IsEmpty())
+	{
+		return SegmentPool.Pop(EAllowShrinking::No);
+	}
+
+	USplineMeshComponent* Segment = NewObject<USplineMeshComponent>(GetOwner());
+	Segment->SetMobility(EComponentMobility::Movable);
+	Segment->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Segment->SetupAttachment(this);
+	Segment->SetStartScale(CableScale, false);
+	Segment->SetEndScale(CableScale, false);
+	Segment->SetStaticMesh(CableMesh);
+	Segment->RegisterComponent();
+	return Segment;
+}
+
+void UPowerlineStreamingComponent::ReleaseSegment(USplineMeshComponent* Segment)
+{
+	if (!Segment) return;
+
+	if (SegmentPool.Num() < MaxPooledSegments && BuiltSpans)
+	{
+		Segment->SetVisibility(false);
+		SegmentPool.Add(Segment);
+		return;
+	}
+	Segment->DestroyComponent();
+}
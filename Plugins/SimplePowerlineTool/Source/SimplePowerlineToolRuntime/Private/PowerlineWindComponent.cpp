@@ -0,0 +1,158 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineWindComponent.h"
+#include "PowerlineWindSimulation.h"
+#include "PowerlineWindSubsystem.h"
+#include "Algo/BinarySearch.h"
+#include "Components/SplineMeshComponent.h"
+#include "Engine/World.h"
+
+namespace PowerlineWindComponent
+{
+	// Segments with no recent frame are treated as culled
+	static constexpr float VisibilityTolerance = 0.2f;
+
+	static constexpr float ConnectedEndpointTolerance = 0.1f;
+
+	static FVector ToVector(const FVector4f& Offset)
+	{
+		return FVector(Offset.X, Offset.Y, Offset.Z);
+	}
+}
+
+UPowerlineWindComponent::UPowerlineWindComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UPowerlineWindComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UPowerlineWindSubsystem* WindSubsystem = GetWorld()->GetSubsystem<UPowerlineWindSubsystem>())
+	{
+		WindSubsystem->RegisterWindComponent(this);
+	}
+}
+
+void UPowerlineWindComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UPowerlineWindSubsystem* WindSubsystem = GetWorld()->GetSubsystem<UPowerlineWindSubsystem>())
+	{
+		WindSubsystem->UnregisterWindComponent(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UPowerlineWindComponent::AddCables(FPowerlineWindSimulation& Simulation)
+{
+	TInlineComponentArray<USplineMeshComponent*> SplineMeshes(GetOwner());
+	Segments.Reset(SplineMeshes.Num());
+	CableHandles.Reset();
+
+	TArray<FVector3f, TInlineAllocator<32>> RestPoints;
+	int32 FirstCableSegment = 0;
+	auto FlushCable = [this, &Simulation, &RestPoints, &FirstCableSegment]()
+		{
+			const int32 CableHandle = Simulation.AddCable(RestPoints);
+			for (int32 Segment = FirstCableSegment; Segment < Segments.Num(); Segment++)
+			{
+				Segments[Segment].CableHandle = CableHandle;
+			}
+			if (CableHandle != INDEX_NONE)
+			{
+				CableHandles.Add(CableHandle);
+			}
+			RestPoints.Reset();
+			FirstCableSegment = Segments.Num();
+		};
+
+	for (USplineMeshComponent* SplineMesh : SplineMeshes)
+	{
+		// A segment that does not start where the previous one ended begins the next cable
+		const bool bContinuesCable = !RestPoints.IsEmpty()
+			&& Segments.Last().EndPosition.Equals(SplineMesh->GetStartPosition(), PowerlineWindComponent::ConnectedEndpointTolerance)
+			&& (SegmentsPerCable <= 0 || Segments.Num() - FirstCableSegment < SegmentsPerCable);
+		if (!bContinuesCable && !RestPoints.IsEmpty())
+		{
+			FlushCable();
+		}
+
+		// Cables are static when generated, the segments have to move now
+		SplineMesh->SetMobility(EComponentMobility::Movable);
+
+		const FTransform& ComponentTransform = SplineMesh->GetComponentTransform();
+		if (RestPoints.IsEmpty())
+		{
+			RestPoints.Add(FVector3f(ComponentTransform.TransformPosition(SplineMesh->GetStartPosition())));
+		}
+		RestPoints.Add(FVector3f(ComponentTransform.TransformPosition(SplineMesh->GetEndPosition())));
+
+		FWindSegment& Segment = Segments.AddDefaulted_GetRef();
+		Segment.SplineMesh = SplineMesh;
+		Segment.StartPoint = RestPoints.Num() - 2;
+		Segment.StartPosition = SplineMesh->GetStartPosition();
+		Segment.StartTangent = SplineMesh->GetStartTangent();
+		Segment.EndPosition = SplineMesh->GetEndPosition();
+		Segment.EndTangent = SplineMesh->GetEndTangent();
+	}
+	if (!RestPoints.IsEmpty())
+	{
+		FlushCable();
+	}
+
+	// Handles of removed cables are reused, so they are not ascending by construction
+	Segments.StableSort([](const FWindSegment& A, const FWindSegment& B) { return A.CableHandle < B.CableHandle; });
+}
+
+void UPowerlineWindComponent::RemoveCables(FPowerlineWindSimulation& Simulation)
+{
+	for (int32 CableHandle : CableHandles)
+	{
+		Simulation.RemoveCable(CableHandle);
+	}
+	CableHandles.Reset();
+	Segments.Reset();
+}
+
+void UPowerlineWindComponent::UpdateVisibility(FPowerlineWindSimulation& Simulation) const
+{
+	int32 CableHandle = INDEX_NONE;
+	bool bVisible = false;
+	for (const FWindSegment& Segment : Segments)
+	{
+		if (Segment.CableHandle != CableHandle)
+		{
+			Simulation.SetCableVisible(CableHandle, bVisible);
+			CableHandle = Segment.CableHandle;
+			bVisible = false;
+		}
+
+		const USplineMeshComponent* SplineMesh = Segment.SplineMesh.Get();
+		bVisible |= SplineMesh && SplineMesh->WasRecentlyRendered(PowerlineWindComponent::VisibilityTolerance);
+	}
+	Simulation.SetCableVisible(CableHandle, bVisible);
+}
+
+void UPowerlineWindComponent::ApplySimulation(const FPowerlineWindSimulation& Simulation, TConstArrayView<int32> UpdatedCables)
+{
+	for (int32 CableHandle : UpdatedCables)
+	{
+		const TConstArrayView<FVector4f> Offsets = Simulation.GetCableOffsets(CableHandle);
+		for (int32 Index = Algo::LowerBoundBy(Segments, CableHandle, &FWindSegment::CableHandle); Index < Segments.Num() && Segments[Index].CableHandle == CableHandle; Index++)
+		{
+			const FWindSegment& Segment = Segments[Index];
+			USplineMeshComponent* SplineMesh = Segment.SplineMesh.Get();
+			if (!SplineMesh || !Offsets.IsValidIndex(Segment.StartPoint + 1)) continue;
+
+			const FTransform& ComponentTransform = SplineMesh->GetComponentTransform();
+			const FVector StartOffset = ComponentTransform.InverseTransformVector(PowerlineWindComponent::ToVector(Offsets[Segment.StartPoint]));
+			const FVector EndOffset = ComponentTransform.InverseTransformVector(PowerlineWindComponent::ToVector(Offsets[Segment.StartPoint + 1]));
+
+			// Only the render state is refreshed, a per frame collision rebuild would cost more than the whole simulation
+			SplineMesh->SetStartAndEnd(Segment.StartPosition + StartOffset, Segment.StartTangent, Segment.EndPosition + EndOffset, Segment.EndTangent, false);
+			SplineMesh->MarkRenderStateDirty();
+		}
+	}
+}
@@ -0,0 +1,166 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineWindSimulation.h"
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+
+namespace PowerlineWindSimulation
+{
+	// Below this many cables the task overhead outweighs the work
+	static constexpr int32 MinCablesForParallelTick = 64;
+}
+
+int32 FPowerlineWindSimulation::AddCable(TArrayView<const FVector3f> RestPoints)
+{
+	FCable Cable;
+	Cable.FirstPoint = Offsets.Num();
+	Cable.NumPoints = RestPoints.Num();
+	if (Cable.NumPoints < 2) return INDEX_NONE;
+
+	// Pendulum length is the deepest point below the chord between the pinned ends
+	const FVector3f& First = RestPoints[0];
+	const FVector3f& Last = RestPoints.Last();
+	float Sag = 0.f;
+	for (int32 Point = 0; Point < Cable.NumPoints; Point++)
+	{
+		const float Alpha = float(Point) / (Cable.NumPoints - 1);
+		Sag = FMath::Max(Sag, FMath::Lerp(First.Z, Last.Z, Alpha) - RestPoints[Point].Z);
+		Cable.Center += RestPoints[Point];
+	}
+	Cable.Center /= float(Cable.NumPoints);
+	Cable.Stiffness = GetStiffness(Sag);
+	Cable.Phase = FMath::Frac((Cable.Center.X + Cable.Center.Y) * 0.0001f) * UE_TWO_PI;
+
+	Offsets.AddZeroed(Cable.NumPoints);
+	PreviousOffsets.AddZeroed(Cable.NumPoints);
+	WindWeights.Reserve(WindWeights.Num() + Cable.NumPoints);
+	for (int32 Point = 0; Point < Cable.NumPoints; Point++)
+	{
+		WindWeights.Add(FMath::Sin(UE_PI * Point / (Cable.NumPoints - 1)));
+	}
+
+	return Cables.Add(Cable);
+}
+
+void FPowerlineWindSimulation::RemoveCable(int32 Cable)
+{
+	if (!Cables.IsValidIndex(Cable)) return;
+
+	NumRemovedPoints += Cables[Cable].NumPoints;
+	Cables.RemoveAt(Cable);
+
+	if (NumRemovedPoints > Offsets.Num() / 2)
+	{
+		CompactPoints();
+	}
+}
+
+void FPowerlineWindSimulation::SetCableVisible(int32 Cable, bool bVisible)
+{
+	if (Cables.IsValidIndex(Cable))
+	{
+		Cables[Cable].bVisible = bVisible;
+	}
+}
+
+TConstArrayView<FVector4f> FPowerlineWindSimulation::GetCableOffsets(int32 Cable) const
+{
+	if (!Cables.IsValidIndex(Cable)) return TConstArrayView<FVector4f>();
+
+	const FCable& CableData = Cables[Cable];
+	return TConstArrayView<FVector4f>(Offsets.GetData() + CableData.FirstPoint, CableData.NumPoints);
+}
+
+void FPowerlineWindSimulation::Tick(float DeltaTime, const FVector3f& ViewLocation)
+{
+	Time += DeltaTime;
+	UpdatedCables.Reset();
+
+	// Update rate drops linearly from every tick at FullRateDistance to MaxUpdateInterval at MaxDistance
+	const float FadeDistance = FMath::Max(Settings.MaxDistance - Settings.FullRateDistance, 1.f);
+	for (TSparseArray<FCable>::TIterator It(Cables); It; ++It)
+	{
+		FCable& Cable = *It;
+		Cable.TimeSinceUpdate += DeltaTime;
+		if (!Cable.bVisible) continue;
+
+		const float Distance = FVector3f::Dist(Cable.Center, ViewLocation);
+		if (Distance > Settings.MaxDistance) continue;
+
+		const float UpdateInterval = FMath::Clamp((Distance - Settings.FullRateDistance) / FadeDistance, 0.f, 1.f) * Settings.MaxUpdateInterval;
+		if (Cable.TimeSinceUpdate < UpdateInterval) continue;
+
+		UpdatedCables.Add(It.GetIndex());
+	}
+
+	const float MaxElapsed = FMath::Max(Settings.MaxUpdateInterval, Settings.MaxStepSeconds);
+	const EParallelForFlags Flags = UpdatedCables.Num() < PowerlineWindSimulation::MinCablesForParallelTick ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+	ParallelFor(UpdatedCables.Num(), [this, MaxElapsed](int32 Index)
+		{
+			FCable& Cable = Cables[UpdatedCables[Index]];
+
+			// Cables coming back into view do not catch up on all the time they were hidden
+			const float Elapsed = FMath::Min(Cable.TimeSinceUpdate, MaxElapsed);
+			Cable.TimeSinceUpdate = 0.f;
+
+			const float Gust = 1.f + Settings.Gustiness * FMath::Sin(float(Time) * Settings.GustFrequency * UE_TWO_PI + Cable.Phase);
+			const int32 NumSteps = FMath::Max(1, FMath::CeilToInt(Elapsed / Settings.MaxStepSeconds));
+			for (int32 Step = 0; Step < NumSteps; Step++)
+			{
+				StepCable(Cable, Elapsed / NumSteps, Gust);
+			}
+		}, Flags);
+}
+
+void FPowerlineWindSimulation::StepCable(FCable& Cable, float StepSeconds, float Gust)
+{
+	// Offset - PreviousOffset covers the previous step, scaled to this step's length it stays a velocity
+	const float StepRatio = Cable.PreviousStepSeconds > 0.f ? StepSeconds / Cable.PreviousStepSeconds : 1.f;
+	Cable.PreviousStepSeconds = StepSeconds;
+
+	const VectorRegister4Float Wind = VectorMultiply(VectorLoadFloat3_W0(&Settings.Wind.X), VectorSetFloat1(Gust));
+	const VectorRegister4Float NegativeStiffness = VectorSetFloat1(-Cable.Stiffness);
+	const VectorRegister4Float Retain = VectorSetFloat1(FMath::Max(0.f, 1.f - Settings.Damping * StepSeconds) * StepRatio);
+	const VectorRegister4Float StepSquared = VectorSetFloat1(StepSeconds * StepSeconds);
+
+	FVector4f* RESTRICT Current = Offsets.GetData() + Cable.FirstPoint;
+	FVector4f* RESTRICT Previous = PreviousOffsets.GetData() + Cable.FirstPoint;
+	const float* RESTRICT Weights = WindWeights.GetData() + Cable.FirstPoint;
+	for (int32 Point = 0; Point < Cable.NumPoints; Point++)
+	{
+		const VectorRegister4Float Offset = VectorLoad(&Current[Point].X);
+		const VectorRegister4Float Velocity = VectorMultiply(VectorSubtract(Offset, VectorLoad(&Previous[Point].X)), Retain);
+
+		// Wind pushes the point, the pendulum pulls it back to the rest pose
+		const VectorRegister4Float Acceleration = VectorMultiplyAdd(Offset, NegativeStiffness, VectorMultiply(Wind, VectorLoadFloat1(&Weights[Point])));
+		const VectorRegister4Float NewOffset = VectorMultiplyAdd(Acceleration, StepSquared, VectorAdd(Offset, Velocity));
+
+		VectorStore(Offset, &Previous[Point].X);
+		VectorStore(NewOffset, &Current[Point].X);
+	}
+}
+
+void FPowerlineWindSimulation::CompactPoints()
+{
+	TArray<FVector4f> NewOffsets;
+	TArray<FVector4f> NewPreviousOffsets;
+	TArray<float> NewWindWeights;
+	const int32 NumPoints = Offsets.Num() - NumRemovedPoints;
+	NewOffsets.Reserve(NumPoints);
+	NewPreviousOffsets.Reserve(NumPoints);
+	NewWindWeights.Reserve(NumPoints);
+
+	for (FCable& Cable : Cables)
+	{
+		const int32 FirstPoint = NewOffsets.Num();
+		NewOffsets.Append(Offsets.GetData() + Cable.FirstPoint, Cable.NumPoints);
+		NewPreviousOffsets.Append(PreviousOffsets.GetData() + Cable.FirstPoint, Cable.NumPoints);
+		NewWindWeights.Append(WindWeights.GetData() + Cable.FirstPoint, Cable.NumPoints);
+		Cable.FirstPoint = FirstPoint;
+	}
+
+	Offsets = MoveTemp(NewOffsets);
+	PreviousOffsets = MoveTemp(NewPreviousOffsets);
+	WindWeights = MoveTemp(NewWindWeights);
+	NumRemovedPoints = 0;
+}
@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PowerlineWindSubsystem.h"
+#include "PowerlineWindComponent.h"
+#include "PowerlineRuntimeUtils.h"
+#include "Engine/World.h"
+
+void UPowerlineWindSubsystem::RegisterWindComponent(UPowerlineWindComponent* Component)
+{
+	if (!Component || Components.Contains(Component)) return;
+
+	Component->AddCables(Simulation);
+	for (int32 CableHandle : Component->GetCableHandles())
+	{
+		CableOwners.Add(CableHandle, Component);
+	}
+	Components.Add(Component);
+}
+
+void UPowerlineWindSubsystem::UnregisterWindComponent(UPowerlineWindComponent* Component)
+{
+	if (!Component || Components.Remove(Component) == 0) return;
+
+	for (int32 CableHandle : Component->GetCableHandles())
+	{
+		CableOwners.Remove(CableHandle);
+	}
+	Component->RemoveCables(Simulation);
+}
+
+void UPowerlineWindSubsystem::SetWind(FVector Wind, float Gustiness)
+{
+	FPowerlineWindSimulation::FSettings Settings = Simulation.GetSettings();
+	Settings.Wind = FVector3f(Wind);
+	Settings.Gustiness = Gustiness;
+	Simulation.SetSettings(Settings);
+}
+
+void UPowerlineWindSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Components.IsEmpty()) return;
+
+	for (UPowerlineWindComponent* Component : Components)
+	{
+		Component->UpdateVisibility(Simulation);
+	}
+
+	Simulation.Tick(DeltaTime, FVector3f(PowerlineRuntime::GetViewLocation(GetWorld())));
+
+	// Group the advanced cables by component, most components only own a handful of cables
+	TMap<UPowerlineWindComponent*, TArray<int32, TInlineAllocator<8>>> UpdatedCablesByComponent;
+	for (int32 CableHandle : Simulation.GetUpdatedCables())
+	{
+		if (const TWeakObjectPtr<UPowerlineWindComponent>* Owner = CableOwners.Find(CableHandle))
+		{
+			if (UPowerlineWindComponent* Component = Owner->Get())
+			{
+				UpdatedCablesByComponent.FindOrAdd(Component).Add(CableHandle);
+			}
+		}
+	}
+	for (const TPair<UPowerlineWindComponent*, TArray<int32, TInlineAllocator<8>>>& Pair : UpdatedCablesByComponent)
+	{
+		Pair.Key->ApplySimulation(Simulation, Pair.Value);
+	}
+}
+
+TStatId UPowerlineWindSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPowerlineWindSubsystem, STATGROUP_Tickables);
+}
+
+bool UPowerlineWindSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
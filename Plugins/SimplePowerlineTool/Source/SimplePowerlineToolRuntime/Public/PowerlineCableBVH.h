@@ -0,0 +1,95 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** One straight cable segment, approximated as a capsule. */
+struct FPowerlineCableCapsule
+{
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+	float Radius = 0.f;
+
+	/** Index of the cable actor this segment belongs to, only used for reporting. */
+	int32 OwnerIndex = INDEX_NONE;
+
+	FBox GetBounds() const
+	{
+		const FVector Extent(Radius);
+		return FBox(Start.ComponentMin(End) - Extent, Start.ComponentMax(End) + Extent);
+	}
+};
+
+/** Pair of capsules whose surfaces are closer than the query tolerance. */
+struct FPowerlineCapsulePair
+{
+	int32 CapsuleA = INDEX_NONE;
+	int32 CapsuleB = INDEX_NONE;
+
+	/** Surface to surface distance, negative when the capsules penetrate. */
+	float Separation = 0.f;
+
+	FVector Location = FVector::ZeroVector;
+};
+
+/** Capsule found by a point, sphere or box query. */
+struct FPowerlineCapsuleHit
+{
+	int32 Capsule = INDEX_NONE;
+
+	/** Point on the capsule axis closest to the query point, or to the box centre for box queries. */
+	FVector Location = FVector::ZeroVector;
+
+	/** From the query point to the capsule surface, negative inside. Zero for box queries. */
+	float Distance = 0.f;
+};
+
+/**
+ * Bounding volume hierarchy over cable capsules.
+ * Built once per check, queries are read only and can run on any thread.
+ */
+class SIMPLEPOWERLINETOOLRUNTIME_API FPowerlineCableBVH
+{
+public:
+	void Build(TArray<FPowerlineCableCapsule>&& InCapsules);
+
+	/** Finds every pair of capsules closer than Tolerance. Capsules sharing an endpoint are connected and skipped. */
+	void FindCloseCapsulePairs(float Tolerance, TArray<FPowerlineCapsulePair>& OutPairs) const;
+
+	/** Appends the indices of all capsules whose bounds overlap Box. */
+	void FindOverlappingCapsules(const FBox& Box, TArray<int32>& OutCapsules) const;
+
+	/** Capsule whose surface is closest to Point within MaxDistance, false when there is none. */
+	bool FindClosestCapsule(const FVector& Point, float MaxDistance, FPowerlineCapsuleHit& OutHit) const;
+
+	/** Appends every capsule touching the sphere. */
+	void FindCapsulesInSphere(const FVector& Center, float Radius, TArray<FPowerlineCapsuleHit>& OutHits) const;
+
+	/** Appends every capsule whose axis passes within its radius of Box, box corners count as square. */
+	void FindCapsulesInBox(const FBox& Box, TArray<FPowerlineCapsuleHit>& OutHits) const;
+
+	const TArray<FPowerlineCableCapsule>& GetCapsules() const { return Capsules; }
+	int32 GetNumNodes() const { return Nodes.Num(); }
+
+private:
+	struct FNode
+	{
+		FBox Bounds = FBox(ForceInit);
+
+		/** First child node for inner nodes, first entry in PrimitiveIndices for leaves. */
+		int32 First = 0;
+
+		/** Zero for inner nodes. */
+		int32 NumPrimitives = 0;
+	};
+
+	template <typename VisitorType>
+	void VisitOverlapping(const FBox& Box, VisitorType&& Visitor) const;
+
+	static constexpr int32 MaxLeafSize = 4;
+
+	TArray<FNode> Nodes;
+	TArray<int32> PrimitiveIndices;
+	TArray<FPowerlineCableCapsule> Capsules;
+};
@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "PowerlineCableCollisionComponent.generated.h"
+
+class UBodySetup;
+class USplineMeshComponent;
+
+USTRUCT()
+struct FPowerlineCollisionCapsule
+{
+	GENERATED_BODY()
+
+	/** Capsule axis end points in component space. */
+	UPROPERTY()
+	FVector3f Start = FVector3f::ZeroVector;
+
+	UPROPERTY()
+	FVector3f End = FVector3f::ZeroVector;
+
+	UPROPERTY()
+	float Radius = 0.f;
+};
+
+/**
+ * Collision for all cables of an actor as one body made of capsules, one per spline mesh segment.
+ * Replaces the deformed mesh collision every segment would otherwise cook and simulate on its own.
+ */
+UCLASS(ClassGroup = (Powerline), meta = (BlueprintSpawnableComponent))
+class SIMPLEPOWERLINETOOLRUNTIME_API UPowerlineCableCollisionComponent : public UPrimitiveComponent
+{
+	GENERATED_BODY()
+
+public:
+	UPowerlineCableCollisionComponent();
+
+	/** Rebuilds the capsules along the current shape of SplineMeshes. */
+	void BuildFromSplineMeshes(TConstArrayView<USplineMeshComponent*> SplineMeshes);
+
+	const TArray<FPowerlineCollisionCapsule>& GetCapsules() const { return Capsules; }
+
+	virtual UBodySetup* GetBodySetup() override;
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+
+protected:
+	/** Adds the capsules to the UPowerlineQuerySubsystem of game worlds. */
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	void UpdateBodySetup();
+
+	UPROPERTY()
+	TArray<FPowerlineCollisionCapsule> Capsules;
+
+	UPROPERTY(Transient, DuplicateTransient)
+	TObjectPtr<UBodySetup> BodySetup;
+};
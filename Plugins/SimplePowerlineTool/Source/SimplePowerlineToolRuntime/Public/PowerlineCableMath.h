@@ -0,0 +1,18 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Cable shape math shared by editor generation and runtime streaming, safe to call from any thread. */
+struct SIMPLEPOWERLINETOOLRUNTIME_API FPowerlineCableMath
+{
+	/** Vertical offset of a cable point, the span hangs down in a parabola that is Sag deep at the middle. */
+	static float GetSagOffset(int32 Index, int32 NumSegments, float Sag);
+
+	/** Evenly spaced points from Start to End including both, NumSegments + 1 entries. */
+	static void ComputeSpanPoints(const FVector& Start, const FVector& End, float Sag, int32 NumSegments, TArrayView<FVector> OutPoints);
+
+	/** Tangents matching a spline with auto tangents through Points, as used by the spline mesh segments. */
+	static void ComputeTangents(TConstArrayView<FVector> Points, TArrayView<FVector> OutTangents);
+};
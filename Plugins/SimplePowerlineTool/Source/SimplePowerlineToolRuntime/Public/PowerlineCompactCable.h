@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PowerlineCompactCable.generated.h"
+
+/**
+ * Cable points stored as 16 bit offsets from the straight line between its ends.
+ * Point i is Lerp(Start, End, i / NumSegments) plus its offset, usually only the sag, so a span needs
+ * 2 bytes per inner point instead of a spline point and a spline mesh segment.
+ * Decoded points are off by at most GetMaxError() per axis, half a quantization step, MaxOffset / 65534.
+ */
+USTRUCT()
+struct SIMPLEPOWERLINETOOLRUNTIME_API FPowerlineCompactCable
+{
+	GENERATED_BODY()
+
+	/** Quantizes Points, the first and last of them are kept as Start and End. */
+	void Encode(TConstArrayView<FVector> Points);
+
+	/** NumSegments + 1 points, tangents follow from FPowerlineCableMath::ComputeTangents. */
+	void Decode(TArrayView<FVector> OutPoints) const;
+
+	int32 GetNumPoints() const { return NumSegments + 1; }
+	float GetMaxError() const { return Quantum * 0.5f; }
+
+	UPROPERTY()
+	FVector3f Start = FVector3f::ZeroVector;
+
+	UPROPERTY()
+	FVector3f End = FVector3f::ZeroVector;
+
+	/** Length of one offset step, zero for a straight cable. */
+	UPROPERTY()
+	float Quantum = 0.f;
+
+	UPROPERTY()
+	uint16 NumSegments = 1;
+
+	/** 0 for a straight cable, 1 when all offsets are vertical, 3 otherwise. */
+	UPROPERTY()
+	uint8 NumOffsetAxes = 0;
+
+	/** NumOffsetAxes values per inner point. */
+	UPROPERTY()
+	TArray<int16> Offsets;
+};
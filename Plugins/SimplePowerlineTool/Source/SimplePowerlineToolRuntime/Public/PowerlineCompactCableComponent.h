@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "PowerlineCompactCable.h"
+#include "PowerlineCompactCableComponent.generated.h"
+
+class USplineMeshComponent;
+class UStaticMesh;
+
+/**
+ * Saves the cables of its actor as FPowerlineCompactCable only.
+ * The spline mesh segments are transient, rebuilt from the quantized points whenever the component is registered.
+ */
+UCLASS(ClassGroup = (Powerline), meta = (BlueprintSpawnableComponent))
+class SIMPLEPOWERLINETOOLRUNTIME_API UPowerlineCompactCableComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Adds a cable through Points given in world space and builds its segments. */
+	void AddCable(TConstArrayView<FVector> Points);
+
+	/** Replaces the shape of Cable with Points given in component space, segments follow on the next RebuildSegments. */
+	void SetCablePoints(int32 Cable, TConstArrayView<FVector> Points);
+
+	/** Updates the segments to the current cables, reusing the existing ones and only creating or destroying the difference. */
+	void RebuildSegments();
+
+	const TArray<FPowerlineCompactCable>& GetCables() const { return Cables; }
+
+	/** Segments built for the cables, in cable order. */
+	TConstArrayView<TObjectPtr<USplineMeshComponent>> GetSegments() const { return Segments; }
+
+	/** Switches the cables to CableMesh at Scale, existing segments are updated in place. */
+	void SetCableMesh(UStaticMesh* NewCableMesh, const FVector2D& NewCableScale);
+
+	/** Largest distance per axis between a stored and a decoded point over all cables. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline")
+	float GetMaxError() const;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Powerline")
+	TObjectPtr<UStaticMesh> CableMesh = nullptr;
+
+	/** Cross section scale of every segment. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Powerline")
+	FVector2D CableScale = FVector2D(1.0, 1.0);
+
+	/** Keep the cable mesh collision on every segment, otherwise collision comes from a UPowerlineCableCollisionComponent if any. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Powerline")
+	bool bSegmentCollision = false;
+
+protected:
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+
+	/** Adds the cables to the UPowerlineQuerySubsystem of game worlds, unless a UPowerlineCableCollisionComponent already does. */
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/** Shapes the segments from FirstSegment on after Cable, creating the missing ones. */
+	void BuildCableSegments(const FPowerlineCompactCable& Cable, int32 FirstSegment);
+	USplineMeshComponent* CreateSegment();
+	void DestroySegments();
+
+	UPROPERTY(EditAnywhere, Category = "Powerline")
+	TArray<FPowerlineCompactCable> Cables;
+
+	UPROPERTY(Transient, DuplicateTransient, TextExportTransient)
+	TArray<TObjectPtr<USplineMeshComponent>> Segments;
+};
@@ -0,0 +1,154 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "PowerlineNetworkGraph.generated.h"
+
+class UInstancedStaticMeshComponent;
+
+USTRUCT()
+struct FPowerlineGraphPole
+{
+	GENERATED_BODY()
+
+	/** Pole actor, or the actor owning Instances. Unset for poles generated from bare transforms. */
+	UPROPERTY()
+	TSoftObjectPtr<AActor> Actor;
+
+	UPROPERTY()
+	TSoftObjectPtr<UInstancedStaticMeshComponent> Instances;
+
+	UPROPERTY()
+	int32 InstanceIndex = INDEX_NONE;
+
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	int32 NumSockets = 1;
+};
+
+USTRUCT()
+struct FPowerlineGraphSpan
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 PoleA = INDEX_NONE;
+
+	UPROPERTY()
+	int32 PoleB = INDEX_NONE;
+
+	/** Socket the cable hangs from on both poles. */
+	UPROPERTY()
+	int32 Socket = 0;
+
+	UPROPERTY()
+	TSoftObjectPtr<AActor> CableActor;
+
+	/** Range of the span's components in UPowerlineNetworkGraph::SpanComponents. */
+	UPROPERTY()
+	int32 FirstComponent = 0;
+
+	UPROPERTY()
+	int32 NumComponents = 0;
+};
+
+/**
+ * Poles, sockets and spans of a level's powerlines and the cable actors and components built for them.
+ * Pole to span adjacency is kept in compressed rows next to the span list, so neighbourhood queries
+ * never touch the world. Actors and components are soft references, the graph can be loaded on its own.
+ */
+UCLASS(BlueprintType)
+class SIMPLEPOWERLINETOOLRUNTIME_API UPowerlineNetworkGraph : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Index of the pole for Actor, or for instance InstanceIndex of Instances, adding it when it is new.
+	 * Poles from bare transforms are found by their exact location.
+	 */
+	int32 AddPole(AActor* Actor, UInstancedStaticMeshComponent* Instances, int32 InstanceIndex, const FVector& Location, int32 NumSockets);
+
+	int32 AddSpan(int32 PoleA, int32 PoleB, int32 Socket, AActor* CableActor, TConstArrayView<UActorComponent*> Components);
+
+	/** Replaces the components of Span, e.g. after its segment count changed. */
+	void SetSpanComponents(int32 Span, TConstArrayView<UActorComponent*> Components);
+
+	/** Forgets every span built by CableActor. Actor and instance poles stay, bare transform poles go with their last span. */
+	void RemoveCableActor(const AActor* CableActor);
+
+	int32 GetNumPoles() const { return Poles.Num(); }
+	int32 GetNumSpans() const { return Spans.Num(); }
+	const FPowerlineGraphPole& GetPole(int32 Pole) const { return Poles[Pole]; }
+	const FPowerlineGraphSpan& GetSpan(int32 Span) const { return Spans[Span]; }
+
+	/** Pole index of Actor, or of one of its instances, INDEX_NONE when it is not part of the network. */
+	int32 FindPole(const AActor* Actor, int32 InstanceIndex = INDEX_NONE) const;
+	int32 FindInstancePole(const UInstancedStaticMeshComponent* Instances, int32 InstanceIndex) const;
+
+	/** Spans touching Pole. */
+	TConstArrayView<int32> GetPoleSpans(int32 Pole) const;
+
+	TConstArrayView<TSoftObjectPtr<UActorComponent>> GetSpanComponents(int32 Span) const;
+
+	/** Spans built by CableActor. */
+	TConstArrayView<int32> FindCableSpans(const AActor* CableActor) const;
+
+	/** Span that Component belongs to, INDEX_NONE when none. A spline shared by several spans maps to the first one. */
+	int32 FindComponentSpan(const UActorComponent* Component) const;
+
+	/** Cable actors attached to any of Poles, each once. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline")
+	TArray<AActor*> GetCableActorsOfPoles(const TArray<AActor*>& PoleActors);
+
+	/** Adjacency rows are saved, so they are brought up to date before and ranges orphaned by SetSpanComponents are dropped. */
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditUndo() override;
+#endif
+
+private:
+	struct FPoleKey
+	{
+		FSoftObjectPath Object;
+		int32 InstanceIndex = INDEX_NONE;
+
+		bool operator==(const FPoleKey& Other) const { return InstanceIndex == Other.InstanceIndex && Object == Other.Object; }
+		friend uint32 GetTypeHash(const FPoleKey& Key) { return HashCombine(GetTypeHash(Key.Object), ::GetTypeHash(Key.InstanceIndex)); }
+	};
+
+	/** Rebuilds the adjacency rows after spans changed, done lazily on the next query. */
+	void RebuildAdjacency() const;
+	/** Packs the component ranges of all spans in span order, dropping entries no span refers to any more. */
+	void CompactSpanComponents();
+	void RebuildLookups();
+	void AddSpanLookups(int32 Span);
+
+	UPROPERTY()
+	TArray<FPowerlineGraphPole> Poles;
+
+	UPROPERTY()
+	TArray<FPowerlineGraphSpan> Spans;
+
+	UPROPERTY()
+	TArray<TSoftObjectPtr<UActorComponent>> SpanComponents;
+
+	/** Spans of pole P are PoleSpanIndices[PoleSpanOffsets[P] .. PoleSpanOffsets[P + 1]). */
+	UPROPERTY()
+	mutable TArray<int32> PoleSpanOffsets;
+
+	UPROPERTY()
+	mutable TArray<int32> PoleSpanIndices;
+
+	mutable bool bAdjacencyDirty = false;
+
+	TMap<FPoleKey, int32> PoleLookup;
+	TMap<FVector, int32> LocationPoleLookup;
+	TMap<FSoftObjectPath, TArray<int32>> CableSpanLookup;
+	TMap<FSoftObjectPath, int32> ComponentSpanLookup;
+};
@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PowerlineCableBVH.h"
+#include "PowerlineQuerySubsystem.generated.h"
+
+USTRUCT(BlueprintType)
+struct FPowerlineCableHit
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	TObjectPtr<AActor> CableActor = nullptr;
+
+	/** Component the cable was indexed from. */
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	TObjectPtr<UActorComponent> Component = nullptr;
+
+	/** Point on the cable closest to the query point, or to the box centre for box queries. */
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	FVector Location = FVector::ZeroVector;
+
+	/** From the query point to the cable surface, negative inside. Zero for box queries. */
+	UPROPERTY(BlueprintReadOnly, Category = "Powerline")
+	float Distance = 0.f;
+};
+
+/**
+ * Spatial index over the cable segments of a game world for nearest cable and overlap queries.
+ * Cable collision, compact and streaming components add their segments when play begins, the index is rebuilt
+ * at most once per frame in Tick. Queries only read the index and can run on any thread at any time. Removed cables are
+ * dropped from results at once, added cables are found from the next rebuild on.
+ */
+UCLASS()
+class SIMPLEPOWERLINETOOLRUNTIME_API UPowerlineQuerySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Indexes Capsules, given in world space, as the cables of Component until RemoveCables. */
+	void AddCables(UActorComponent* Component, TArray<FPowerlineCableCapsule>&& Capsules);
+	void RemoveCables(UActorComponent* Component);
+
+	UFUNCTION(BlueprintCallable, Category = "Powerline")
+	bool FindClosestCable(const FVector& Location, float MaxDistance, FPowerlineCableHit& OutHit) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Powerline")
+	void FindCablesInSphere(const FVector& Center, float Radius, TArray<FPowerlineCableHit>& OutHits) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Powerline")
+	void FindCablesInBox(const FBox& Box, TArray<FPowerlineCableHit>& OutHits) const;
+
+	int32 GetNumSegments() const { return BVH.GetCapsules().Num(); }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Rebuilds the index when cables were added or removed, game thread only. */
+	void RebuildIfDirty();
+	void ToCableHits(TConstArrayView<FPowerlineCapsuleHit> Hits, TArray<FPowerlineCableHit>& OutHits) const;
+
+	/** Segments of every indexed component, flattened into the index on rebuild. */
+	TMap<UActorComponent*, TArray<FPowerlineCableCapsule>> ComponentCables;
+
+	/** Components by FPowerlineCableCapsule::OwnerIndex of the current index, removed ones are null until the next rebuild. */
+	TArray<UActorComponent*> Owners;
+	FPowerlineCableBVH BVH;
+	bool bDirty = false;
+
+	/** Queries hold it for reading, rebuilds for writing. */
+	mutable FRWLock Lock;
+};
@@ -0,0 +1,21 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USplineMeshComponent;
+class UStaticMesh;
+class UWorld;
+
+namespace PowerlineRuntime
+{
+	/** Camera location of the first local player, the world origin when there is none. */
+	SIMPLEPOWERLINETOOLRUNTIME_API FVector GetViewLocation(const UWorld* World);
+
+	/** Radius of an undeformed cable mesh running along X, zero without a mesh. */
+	SIMPLEPOWERLINETOOLRUNTIME_API float GetCableMeshRadius(const UStaticMesh* CableMesh);
+
+	/** Sets the mesh and cross section scale of a cable segment, render state and collision are rebuilt once. */
+	SIMPLEPOWERLINETOOLRUNTIME_API void SetSegmentMesh(USplineMeshComponent* Segment, UStaticMesh* CableMesh, const FVector2D& Scale);
+}
@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PowerlineSagTable.generated.h"
+
+/** Physical description of a conductor, the sag of a span follows from it and the span geometry. */
+USTRUCT(BlueprintType)
+struct SIMPLEPOWERLINETOOLRUNTIME_API FPowerlineConductorProfile
+{
+	GENERATED_BODY()
+
+	/** Defaults are roughly an ACSR "Drake" conductor. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Conductor", meta = (ClampMin = "0.01", Units = "Kilograms"))
+	float MassPerMeter = 1.63f;
+
+	/** Horizontal tension the line is strung with at ReferenceTemperature. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Conductor", meta = (ClampMin = "1.0", Units = "Newtons"))
+	float Tension = 28000.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Conductor", meta = (Units = "Celsius"))
+	float Temperature = 15.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Conductor", meta = (Units = "Celsius"))
+	float ReferenceTemperature = 15.f;
+
+	/** Linear thermal expansion per degree, a warmer conductor is longer and sags more. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Conductor", meta = (ClampMin = "0.0"))
+	float ThermalExpansion = 19.3e-6f;
+
+	/** Longest span the table covers, longer spans are clamped. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Conductor", meta = (ClampMin = "100.0", Units = "Centimeters"))
+	float MaxSpanLength = 60000.f;
+
+	/** Largest height difference between span ends the table covers. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Conductor", meta = (ClampMin = "0.0", Units = "Centimeters"))
+	float MaxHeightDifference = 10000.f;
+
+	bool operator==(const FPowerlineConductorProfile& Other) const;
+};
+
+/**
+ * Mid span sag of a conductor over span length and height difference.
+ * Every entry solves the inclined catenary once, including the thermal elongation, queries only interpolate.
+ */
+class SIMPLEPOWERLINETOOLRUNTIME_API FPowerlineSagTable
+{
+public:
+	static constexpr int32 NumLengthSamples = 64;
+	static constexpr int32 NumHeightSamples = 32;
+
+	void Build(const FPowerlineConductorProfile& InProfile);
+	bool IsBuiltFor(const FPowerlineConductorProfile& InProfile) const { return !Sags.IsEmpty() && Profile == InProfile; }
+
+	/** Vertical distance between the chord and the cable at mid span in cm, lengths in cm. */
+	float GetSag(float SpanLength, float HeightDifference) const;
+
+	/** Same as GetSag for a span between two points. */
+	float GetSag(const FVector& Start, const FVector& End) const;
+
+	/** Exact catenary sag without the table, what every entry is built from. */
+	static float ComputeSag(const FPowerlineConductorProfile& Profile, float SpanLength, float HeightDifference);
+
+private:
+	FPowerlineConductorProfile Profile;
+
+	/** NumHeightSamples rows of NumLengthSamples sags each. */
+	TArray<float> Sags;
+};
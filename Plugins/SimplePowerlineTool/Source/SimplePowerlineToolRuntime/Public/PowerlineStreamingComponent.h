@@ -0,0 +1,149 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "Containers/Queue.h"
+#include "PowerlineStreamingComponent.generated.h"
+
+class USplineMeshComponent;
+class UStaticMesh;
+struct FPowerlineCableCapsule;
+
+/** One cable between two endpoints, all a streamed cable needs while it is not loaded. */
+USTRUCT()
+struct FPowerlineSpanDescriptor
+{
+	GENERATED_BODY()
+
+	/** Endpoints relative to the owning UPowerlineStreamingComponent. */
+	UPROPERTY(EditAnywhere, Category = "Powerline")
+	FVector3f Start = FVector3f::ZeroVector;
+
+	UPROPERTY(EditAnywhere, Category = "Powerline")
+	FVector3f End = FVector3f::ZeroVector;
+
+	UPROPERTY(EditAnywhere, Category = "Powerline")
+	float Sag = 0.f;
+
+	UPROPERTY(EditAnywhere, Category = "Powerline", meta = (ClampMin = "1"))
+	uint16 NumSegments = 1;
+};
+
+/**
+ * Builds the cables of its span descriptors only while the viewer is near them.
+ * Cable shapes are computed on worker threads, the game thread only applies them to pooled spline mesh segments
+ * and hides spans again once the viewer moves away, so cost and memory follow the cables in range, not the map.
+ */
+UCLASS(ClassGroup = (Powerline), meta = (BlueprintSpawnableComponent))
+class SIMPLEPOWERLINETOOLRUNTIME_API UPowerlineStreamingComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+public:
+	UPowerlineStreamingComponent();
+
+	/** Adds a span given in world space. */
+	void AddSpan(const FVector& Start, const FVector& End, float Sag, int32 NumSegments);
+
+	/** Changes the sag and segment count of a span, the endpoints stay. Loaded spans pick it up once they are built again. */
+	void SetSpanShape(int32 Span, float Sag, int32 NumSegments);
+
+	const TArray<FPowerlineSpanDescriptor>& GetSpans() const { return Spans; }
+
+	/** Appends one world space capsule per segment of every span, whether the span is built or not. */
+	void GetSpanCapsules(TArray<FPowerlineCableCapsule>& OutCapsules) const;
+
+	/** Switches the cables to CableMesh at Scale, loaded and pooled segments are updated in place. */
+	void SetCableMesh(UStaticMesh* NewCableMesh, const FVector2D& NewCableScale);
+
+	UFUNCTION(BlueprintCallable, Category = "Powerline")
+	int32 GetNumLoadedSpans() const { return LoadedSegments.Num(); }
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Powerline")
+	TObjectPtr<UStaticMesh> CableMesh = nullptr;
+
+	/** Cross section scale of every segment. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Powerline")
+	FVector2D CableScale = FVector2D(1.0, 1.0);
+
+	/** Spans closer to the viewer than this are built. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline", meta = (ClampMin = "0.0"))
+	float StreamingRadius = 30000.f;
+
+	/** Extra distance before a built span is released, stops spans on the border from flickering in and out. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline", meta = (ClampMin = "0.0"))
+	float ReleaseMargin = 3000.f;
+
+	/** Built spans applied to components per tick, the rest waits for the next one. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline", meta = (ClampMin = "1"))
+	int32 MaxSpansAppliedPerTick = 64;
+
+	/** Hidden segments kept for reuse, released segments past this are destroyed. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Powerline", meta = (ClampMin = "0"))
+	int32 MaxPooledSegments = 1024;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+	/** Shape of one span computed off the game thread, in component space. */
+	struct FBuiltSpan
+	{
+		int32 Span = INDEX_NONE;
+		uint32 Request = 0;
+		TArray<FVector> Points;
+		TArray<FVector> Tangents;
+	};
+	using FBuiltSpanQueue = TQueue<FBuiltSpan, EQueueMode::Mpsc>;
+
+	enum class ESpanState : uint8
+	{
+		Unloaded,
+		Building,
+		Loaded,
+	};
+
+	struct FSpanRuntime
+	{
+		ESpanState State = ESpanState::Unloaded;
+
+		/** Bumped on every request so results of a span released while building are dropped. */
+		uint32 Request = 0;
+	};
+
+	void BuildSpanGrid();
+	void RequestSpansInRange(const FVector& ViewLocation);
+	void ReleaseSpansOutOfRange(const FVector& ViewLocation);
+	void ApplyBuiltSpans();
+	void ReleaseSpan(int32 Span);
+	float GetSpanDistance(int32 Span, const FVector& ViewLocation) const;
+
+	USplineMeshComponent* AcquireSegment();
+	void ReleaseSegment(USplineMeshComponent* Segment);
+
+	UPROPERTY(EditAnywhere, Category = "Powerline")
+	TArray<FPowerlineSpanDescriptor> Spans;
+
+	TArray<FSpanRuntime> SpanRuntime;
+
+	/** Spans in the Building or Loaded state. */
+	TArray<int32> ActiveSpans;
+
+	/** Spans indexed by the grid cells their bounds touch. */
+	TMap<FIntPoint, TArray<int32>> SpanGrid;
+	float GridCellSize = 0.f;
+
+	/** Segments showing each loaded span, the owner keeps them referenced. */
+	TMap<int32, TArray<TWeakObjectPtr<USplineMeshComponent>>> LoadedSegments;
+
+	/** Hidden segments ready for the next span. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USplineMeshComponent>> SegmentPool;
+
+	/** Shared with the build tasks so they can finish safely after the component is gone. */
+	TSharedPtr<FBuiltSpanQueue, ESPMode::ThreadSafe> BuiltSpans;
+};
@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "PowerlineWindComponent.generated.h"
+
+class FPowerlineWindSimulation;
+class USplineMeshComponent;
+
+/**
+ * Makes the cables of its owner sway in wind.
+ * Consecutive spline mesh segments that share endpoints form one cable in UPowerlineWindSubsystem's simulation,
+ * the simulated offsets are written back into the existing segments, nothing is recreated.
+ */
+UCLASS(ClassGroup = (Powerline), meta = (BlueprintSpawnableComponent))
+class SIMPLEPOWERLINETOOLRUNTIME_API UPowerlineWindComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UPowerlineWindComponent();
+
+	/** Adds the owner's cables to Simulation. */
+	void AddCables(FPowerlineWindSimulation& Simulation);
+	void RemoveCables(FPowerlineWindSimulation& Simulation);
+
+	/** Cables are only simulated while one of their segments was rendered recently. */
+	void UpdateVisibility(FPowerlineWindSimulation& Simulation) const;
+
+	/** Moves the segments of the cables advanced in the last simulation tick. */
+	void ApplySimulation(const FPowerlineWindSimulation& Simulation, TConstArrayView<int32> UpdatedCables);
+
+	const TArray<int32>& GetCableHandles() const { return CableHandles; }
+
+	/** Splits chained segments into cables of this many segments, for cables running over several poles. 0 keeps every chain whole. */
+	UPROPERTY(EditAnywhere, Category = "Powerline", meta = (ClampMin = "0"))
+	int32 SegmentsPerCable = 0;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	struct FWindSegment
+	{
+		TWeakObjectPtr<USplineMeshComponent> SplineMesh;
+		int32 CableHandle = INDEX_NONE;
+
+		/** Control point at the segment start, the end is the next one. */
+		int32 StartPoint = 0;
+
+		FVector StartPosition;
+		FVector StartTangent;
+		FVector EndPosition;
+		FVector EndTangent;
+	};
+
+	/** Sorted by CableHandle so updates touch each cable's segments in one run. */
+	TArray<FWindSegment> Segments;
+	TArray<int32> CableHandles;
+};
@@ -0,0 +1,114 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/SparseArray.h"
+
+/**
+ * Wind sway for many cables at once, free of any UObject so it can run and be checked headlessly.
+ *
+ * All control points of all cables live in one contiguous buffer of float4 offsets from the rest pose.
+ * Every point is a damped pendulum pushed by the wind, integrated with time corrected verlet using SIMD registers,
+ * so the sway does not depend on the frame rate or on how often a cable is updated.
+ * End points carry zero wind weight, so cables stay pinned to their sockets.
+ */
+class SIMPLEPOWERLINETOOLRUNTIME_API FPowerlineWindSimulation
+{
+public:
+	struct FSettings
+	{
+		/** Wind acceleration in cm/s^2, direction and strength in one vector. */
+		FVector3f Wind = FVector3f(300.f, 0.f, 0.f);
+
+		/** Fraction of the wind that varies over time. */
+		float Gustiness = 0.5f;
+
+		float GustFrequency = 0.4f;
+
+		/** Fraction of velocity lost per second. */
+		float Damping = 0.8f;
+
+		/** Cables closer than this are simulated every tick. */
+		float FullRateDistance = 5000.f;
+
+		/** Cables further away than this are not simulated at all. */
+		float MaxDistance = 50000.f;
+
+		/** Longest time between two updates of a cable at MaxDistance. */
+		float MaxUpdateInterval = 0.25f;
+
+		/** Larger steps are split so the integration stays stable. */
+		float MaxStepSeconds = 1.f / 30.f;
+	};
+
+	void SetSettings(const FSettings& InSettings) { Settings = InSettings; }
+	const FSettings& GetSettings() const { return Settings; }
+
+	/** Adds a cable given its control points in world space, returns a handle that stays valid until RemoveCable. */
+	int32 AddCable(TArrayView<const FVector3f> RestPoints);
+	void RemoveCable(int32 Cable);
+
+	/** Invisible cables keep their last pose and are not advanced. */
+	void SetCableVisible(int32 Cable, bool bVisible);
+
+	/** Advances every visible cable that is due for an update at its distance from ViewLocation. */
+	void Tick(float DeltaTime, const FVector3f& ViewLocation);
+
+	/** Cables advanced by the last Tick. */
+	const TArray<int32>& GetUpdatedCables() const { return UpdatedCables; }
+
+	/** Offsets of a cable's control points from their rest positions, xyz used. */
+	TConstArrayView<FVector4f> GetCableOffsets(int32 Cable) const;
+
+	int32 GetNumCables() const { return Cables.Num(); }
+	int32 GetNumPoints() const { return Offsets.Num(); }
+
+	static constexpr float Gravity = 981.f;
+
+	/** Nearly straight cables would get an unbounded pendulum frequency. */
+	static constexpr float MinSag = 50.f;
+
+	/** Pendulum pull per cm of offset of a cable hanging Sag below its chord, a steady wind settles at Wind / stiffness. */
+	static float GetStiffness(float Sag) { return Gravity / FMath::Max(Sag, MinSag); }
+
+private:
+	struct FCable
+	{
+		int32 FirstPoint = 0;
+		int32 NumPoints = 0;
+
+		FVector3f Center = FVector3f::ZeroVector;
+
+		/** Pendulum stiffness g / sag in 1/s^2. */
+		float Stiffness = 1.f;
+
+		/** Keeps gusts of neighbouring cables out of phase. */
+		float Phase = 0.f;
+
+		float TimeSinceUpdate = 0.f;
+
+		/** Length of the step that produced the current offsets, the velocity term is rescaled by it. */
+		float PreviousStepSeconds = 0.f;
+
+		bool bVisible = true;
+	};
+
+	void StepCable(FCable& Cable, float StepSeconds, float Gust);
+	void CompactPoints();
+
+	FSettings Settings;
+
+	TSparseArray<FCable> Cables;
+
+	TArray<FVector4f> Offsets;
+	TArray<FVector4f> PreviousOffsets;
+
+	/** Per point share of the wind, zero at pinned ends and largest mid span. */
+	TArray<float> WindWeights;
+
+	int32 NumRemovedPoints = 0;
+	double Time = 0.0;
+
+	TArray<int32> UpdatedCables;
+};
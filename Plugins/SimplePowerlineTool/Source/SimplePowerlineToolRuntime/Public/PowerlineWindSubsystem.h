@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PowerlineWindSimulation.h"
+#include "PowerlineWindSubsystem.generated.h"
+
+class UPowerlineWindComponent;
+
+/** Owns the wind simulation of every UPowerlineWindComponent in a game world and advances it once per frame. */
+UCLASS()
+class SIMPLEPOWERLINETOOLRUNTIME_API UPowerlineWindSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterWindComponent(UPowerlineWindComponent* Component);
+	void UnregisterWindComponent(UPowerlineWindComponent* Component);
+
+	/** Direction and strength of the wind as acceleration in cm/s^2. */
+	UFUNCTION(BlueprintCallable, Category = "Powerline")
+	void SetWind(FVector Wind, float Gustiness = 0.5f);
+
+	const FPowerlineWindSimulation& GetSimulation() const { return Simulation; }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FPowerlineWindSimulation Simulation;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UPowerlineWindComponent>> Components;
+
+	/** Maps simulation cable handles back to their component. */
+	TMap<int32, TWeakObjectPtr<UPowerlineWindComponent>> CableOwners;
+};
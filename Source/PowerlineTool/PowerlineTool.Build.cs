@@ -8,7 +8,7 @@ public class PowerlineTool : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 	
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "UMG", "Blutility", "UnrealEd" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "UMG", "Blutility", "UnrealEd", "SimplePowerlineTool" });
 
 		PrivateDependencyModuleNames.AddRange(new string[] {  });
 
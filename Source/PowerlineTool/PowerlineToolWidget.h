@@ -9,12 +9,12 @@
 
 #include "CoreMinimal.h"
 #include "EditorUtilityWidget.h"
+#include "PowerlineToolTypes.h"
 #include "PowerlineToolWidget.generated.h"
 
 class UEditorUtilityButton;
 class UEditorUtilityCheckBox;
 class UEditorUtilitySlider;
-class USplineComponent;
 
 UCLASS()
 class POWERLINETOOL_API UPowerlineToolWidget : public UEditorUtilityWidget
@@ -64,25 +64,11 @@ protected:
 	UFUNCTION()
 	void CreatePowerlines();
 
-	void ClearData();
-
-	bool SelectedObjects();
-	bool SocketAmount(AActor* Object);
-	void SocketLocation(FPermissionListOwners& SocketsName, UStaticMeshComponent* MeshComponent);
-	USplineComponent* CreateSplineComponent(AActor* CableActor);
-	void CreateSplineMeshComponents(USplineComponent* SplineComp, AActor* CableActor);
-	void SetPointsCurve(USplineComponent* SplineComp);
-	void SetSplinePointsLocation(USplineComponent* SplineComp, int32 Index);
-	void CreateSplinePoints(USplineComponent* SplineComp);
-	void CreateRootComponent(AActor* CableActor);
+	FPowerlineGenerationSettings GetGenerationSettings() const;
 
 	virtual void NativeConstruct() override;
 
 private:
-	UPROPERTY(VisibleAnywhere)
-	TArray<FVector> ObjectsLocations;
-	UPROPERTY(VisibleAnywhere)
-	TArray<AActor*> ObjectSelection;
 	UPROPERTY(VisibleAnywhere)
 	int32 Segments = 10;
 	UPROPERTY(VisibleAnywhere)
@@ -91,10 +77,5 @@ private:
 	UStaticMesh* CableMesh;
 	UPROPERTY(VisibleAnywhere)
 	bool bAttachToSockets = false;
-
-	UPROPERTY(VisibleAnywhere)
-	int32 AmountOfSockets = 0;
-	UPROPERTY(VisibleAnywhere)
-	TArray<FVector> SocketsLocations;
 	
 };